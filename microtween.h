@@ -1,326 +1,1643 @@
-#pragma once
-#include <vector>
-#include <cmath>
-#include <functional>
-
-class microtween
-{
-public:
-
-	enum class easing {
-		linear,
-		sine_in,
-		sine_out,
-		sine_in_out,
-		quadratic_in,
-		quadratic_out,
-		quadratic_in_out,
-		cubic_in,
-		cubic_out,
-		cubic_in_out,
-		quartic_in,
-		quartic_out,
-		quartic_in_out,
-		quintic_in,
-		quintic_out,
-		quintic_in_out,
-		exponential_in,
-		exponential_out,
-		exponential_in_out,
-		circular_in,
-		circular_out,
-		circular_in_out,
-		elastic_in,
-		elastic_out,
-		elastic_in_out,
-		back_in,
-		back_out,
-		back_in_out
-	};
-
-	typedef std::function<void(void)> cb_t;
-
-	microtween& reset(float v)
-	{
-		sequence.clear();
-		from_value = v;
-		cursor = 0;
-		return *this;
-	}
-
-	microtween& reset(int v)
-	{
-		return reset(static_cast<float>(v));
-	}
-
-	microtween& to(float end, int d, easing e = microtween::easing::linear)
-	{
-		sequence.emplace_back(end, d, e);
-		return *this;
-	}
-
-	microtween& to(int end, int d, easing e = microtween::easing::linear)
-	{
-		return to(static_cast<float>(end), d, e);
-	}
-
-	microtween& wait(int d)
-	{
-		float end = from_value;
-		if (!sequence.empty())
-			end = sequence.back().end;
-		return to(end, d);
-	}
-
-	microtween& call(const cb_t& cb)
-	{
-		sequence.back().cb = cb;
-		return *this;
-	}
-
-	void step(int s = 1)
-	{
-		int c = cursor;
-		for (const auto& i : sequence)
-		{
-			if (c < i.duration)
-			{
-				if (i.cb && c + s >= i.duration)
-					i.cb();
-				break;
-			}
-			c -= i.duration;
-		}
-
-		cursor += s;
-	}
-
-	float get() const
-	{
-		return get(cursor);
-	}
-
-	float get(int c) const
-	{
-		if (sequence.empty())
-			return from_value;
-
-		float start = from_value;
-		for (const auto& i : sequence)
-		{
-			if (c < i.duration)
-				return start + (i.end - start) * interpolate(static_cast<float>(c) / i.duration, i.easing);
-			c -= i.duration;
-			start = i.end;
-		}
-
-		return sequence.back().end;
-	}
-
-	int geti(int c) const
-	{
-		return static_cast<int>(roundf(get(c)));
-	}
-
-	int geti() const
-	{
-		return geti(cursor);
-	}
-
-	int duration() const
-	{
-		int result = 0;
-		for (const auto& i : sequence)
-			result += i.duration;
-		return result;
-	}
-
-	bool finished() const
-	{
-		return cursor >= duration();
-	}
-
-private:
-	struct tween_point
-	{
-		tween_point(float end, int duration, easing easing) : end(end),
-			duration(duration), easing(easing) {}
-		float end;
-		int duration;
-		easing easing;
-		cb_t cb;
-	};
-
-	float from_value = 0;
-	int cursor = 0;
-	std::vector<tween_point> sequence;
-	float interpolate(float t, easing e) const
-	{
-		const float pi = 3.141592654f;
-		const float half_pi = 1.570796327f;
-
-		switch (e)
-		{
-		case easing::sine_in:
-			return 1.f + sinf(half_pi * (t - 1.0f));
-
-		case easing::sine_out:
-			return sinf(half_pi * t);
-
-		case easing::sine_in_out:
-			return .5f * (1.f - cosf(t * pi));
-
-		case easing::quadratic_in:
-			return t * t;
-
-		case easing::quadratic_out:
-			return -1.f * t * (t - 2);
-
-		case easing::quadratic_in_out:
-			t *= 2;
-			if (t < 1)
-				return .5f * t * t;
-			--t;
-			return -.5f * (t * (t - 2) - 1);
-
-		case easing::cubic_in:
-			return t * t * t;
-
-		case easing::cubic_out:
-			--t;
-			return t * t * t + 1;
-
-		case easing::cubic_in_out:
-			t *= 2;
-			if (t < 1)
-				return .5f * t * t * t;
-			t -= 2;
-			return .5f * (t * t * t + 2);
-
-		case easing::quartic_in:
-			return t * t * t * t;
-
-		case easing::quartic_out:
-			--t;
-			return -(t * t * t * t - 1);
-
-		case easing::quartic_in_out:
-			t *= 2;
-			if (t < 1)
-				return .5f * (t * t * t * t);
-			t -= 2;
-			return -.5f * (t * t * t * t - 2);
-
-		case easing::quintic_in:
-		{
-			return powf(t, 5);
-		}
-
-		case easing::quintic_out:
-		{
-			return 1.f + powf(t - 1.f, 5);
-		}
-
-		case easing::quintic_in_out:
-		{
-			if (t < .5f)
-				return 16.f * powf(t, 5);
-
-			return 1.f - 16.f * powf(t - 1.f, 5);
-		}
-
-		case easing::exponential_in:
-			return powf(2, 10 * (t - 1));
-
-		case easing::exponential_out:
-			return -powf(2, -10 * t) + 1;
-
-		case easing::exponential_in_out:
-			t *= 2;
-			if (t < 1)
-				return .5f * powf(2, 10 * (t - 1));
-			--t;
-			return .5f * (-powf(2, -10 * t) + 2);
-
-		case easing::circular_in:
-			return -(sqrtf(1 - t * t) - 1);
-
-		case easing::circular_out:
-			--t;
-			return sqrtf(1 - t * t);
-
-		case easing::circular_in_out:
-			t *= 2;
-			if (t < 1)
-				return -.5f * (sqrtf(1 - t * t) - 1);
-			t -= 2;
-			return .5f * (sqrtf(1 - t * t) + 1);
-
-		case easing::elastic_in:
-		{
-			if (t <= 0.00001f)
-				return 0.f;
-			if (t >= 0.999f)
-				return 1.f;
-			float p = .3f;
-			float s = p / 4;
-			float postFix = powf(2, 10 * (t -= 1)); // this is a fix, again, with post-increment operators
-			return -(postFix * sinf((t - s) * (2 * static_cast<float>(pi)) / p));
-		}
-
-		case easing::elastic_out:
-		{
-			if (t <= 0.00001f)
-				return 0.f;
-			if (t >= 0.999f)
-				return 1.f;
-			float p = .3f;
-			float s = p / 4;
-			return powf(2, -10 * t) * sinf((t - s) * (2 * static_cast<float>(pi)) / p) + 1.f;
-		}
-
-		case easing::elastic_in_out:
-		{
-			if (t <= 0.00001f)
-				return 0.f;
-			if (t >= 0.999f)
-				return 1.f;
-			t *= 2;
-			float p = (.3f * 1.5f);
-			float s = p / 4;
-			float postFix;
-			if (t < 1)
-			{
-				postFix = powf(2, 10 * (t -= 1));
-				return -0.5f * (postFix * sinf((t - s) * (2 * static_cast<float>(pi)) / p));
-			}
-			postFix = powf(2, -10 * (t -= 1));
-			return postFix * sinf((t - s) * (2 * static_cast<float>(pi)) / p) * .5f + 1.f;
-		}
-
-		case easing::back_in:
-		{
-			float s = 1.70158f;
-			return t * t * ((s + 1) * t - s);
-		}
-
-		case easing::back_out:
-		{
-			float s = 1.70158f;
-			t -= 1;
-			return t * t * ((s + 1) * t + s) + 1;
-		}
-
-		case easing::back_in_out:
-		{
-			float s = 1.70158f * 1.525f;
-			if ((t /= .5f) < 1)
-				return .5f * (t * t * ((s + 1) * t - s));
-			float p = t -= 2;
-			return .5f * (p * t * ((s + 1) * t + s) + 2);
-		}
-
-		}
-		return t;
-	}
-};
+#pragma once
+#include <vector>
+#include <array>
+#include <memory>
+#include <cmath>
+#include <climits>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include "microtween_math.h"
+#include "microtween_small_vector.h"
+
+class microtween_lut;
+
+// A void() callable kept inside the object instead of on the heap. Anything
+// up to capacity bytes fits (lambdas capturing a few pointers or references);
+// larger callables fail to compile. A plain function with a context pointer
+// can be bound with the two-argument constructor. Callables that test false,
+// like an empty std::function or a null function pointer, make an empty
+// callback.
+class microtween_callback
+{
+public:
+	static const std::size_t capacity = 4 * sizeof(void*);
+
+	microtween_callback() {}
+
+	template <class F, class = typename std::enable_if<!std::is_same<typename std::decay<F>::type, microtween_callback>::value>::type>
+	microtween_callback(F&& f)
+	{
+		typedef typename std::decay<F>::type fn;
+		static_assert(sizeof(fn) <= capacity, "callback is too large to be stored in place");
+		static_assert(alignof(fn) <= alignof(storage), "callback is over-aligned");
+		if (empty(f, 0))
+			return;
+		new (&buffer) fn(std::forward<F>(f));
+		table = &ops<fn>::table;
+	}
+
+	microtween_callback(void (*f)(void*), void* context) : microtween_callback([f, context] { f(context); }) {}
+
+	microtween_callback(const microtween_callback& other) : table(other.table)
+	{
+		if (table)
+			table->copy(&buffer, &other.buffer);
+	}
+
+	microtween_callback& operator=(const microtween_callback& other)
+	{
+		if (this != &other)
+		{
+			reset();
+			table = other.table;
+			if (table)
+				table->copy(&buffer, &other.buffer);
+		}
+		return *this;
+	}
+
+	~microtween_callback()
+	{
+		reset();
+	}
+
+	explicit operator bool() const
+	{
+		return table != nullptr;
+	}
+
+	void operator()() const
+	{
+		table->invoke(&buffer);
+	}
+
+private:
+	typedef typename std::aligned_storage<capacity>::type storage;
+
+	struct vtable
+	{
+		void (*invoke)(const void*);
+		void (*copy)(void*, const void*);
+		void (*destroy)(void*);
+	};
+
+	template <class F>
+	struct ops
+	{
+		static void invoke(const void* p) { (*static_cast<F*>(const_cast<void*>(p)))(); }
+		static void copy(void* to, const void* from) { new (to) F(*static_cast<const F*>(from)); }
+		static void destroy(void* p) { static_cast<F*>(p)->~F(); }
+		static const vtable table;
+	};
+
+	storage buffer;
+	const vtable* table = nullptr;
+
+	template <class F>
+	static auto empty(const F& f, int) -> decltype(static_cast<bool>(f), bool())
+	{
+		return !static_cast<bool>(f);
+	}
+
+	template <class F>
+	static bool empty(const F&, long)
+	{
+		return false;
+	}
+
+	void reset()
+	{
+		if (table)
+			table->destroy(&buffer);
+		table = nullptr;
+	}
+};
+
+template <class F>
+const microtween_callback::vtable microtween_callback::ops<F>::table = { &invoke, &copy, &destroy };
+
+// How a tween blends two values of type T. Specialize for types without
+// a + (b - a) * t.
+template <class T>
+struct microtween_traits
+{
+	static T lerp(const T& a, const T& b, float t)
+	{
+		return a + (b - a) * t;
+	}
+};
+
+template <class T, std::size_t N>
+struct microtween_traits<std::array<T, N>>
+{
+	static std::array<T, N> lerp(const std::array<T, N>& a, const std::array<T, N>& b, float t)
+	{
+		std::array<T, N> r;
+		for (std::size_t i = 0; i < N; ++i)
+			r[i] = microtween_traits<T>::lerp(a[i], b[i], t);
+		return r;
+	}
+};
+
+// Easings, shared by tweens of every value type.
+class microtween_base
+{
+public:
+
+	enum class easing : std::uint8_t {
+		linear,
+		sine_in,
+		sine_out,
+		sine_in_out,
+		quadratic_in,
+		quadratic_out,
+		quadratic_in_out,
+		cubic_in,
+		cubic_out,
+		cubic_in_out,
+		quartic_in,
+		quartic_out,
+		quartic_in_out,
+		quintic_in,
+		quintic_out,
+		quintic_in_out,
+		exponential_in,
+		exponential_out,
+		exponential_in_out,
+		circular_in,
+		circular_out,
+		circular_in_out,
+		elastic_in,
+		elastic_out,
+		elastic_in_out,
+		back_in,
+		back_out,
+		back_in_out
+	};
+
+	typedef microtween_callback cb_t;
+
+	// Easing E at t, without the dispatch of interpolate(), so it inlines into
+	// loops where the easing is known at compile time. easer(e) returns the
+	// same function as a pointer, for hoisting the dispatch out of a loop.
+	template <easing E>
+	static float ease(float t);
+
+	typedef float (*ease_fn)(float);
+	static ease_fn easer(easing e);
+
+	static float interpolate(float t, easing e);
+
+	// Easing defined by a shared object such as a microtween_bezier: the object
+	// and the function evaluating it. The object must outlive the tweens
+	// using it.
+	struct curve
+	{
+		float (*fn)(const void*, float);
+		const void* object;
+
+		float operator()(float t) const
+		{
+			return fn(object, t);
+		}
+	};
+
+	template <class C>
+	static curve make_curve(const C& c)
+	{
+		return { &call<C>, &c };
+	}
+
+private:
+	template <class C>
+	static float call(const void* c, float t)
+	{
+		return (*static_cast<const C*>(c))(t);
+	}
+
+	// Transcendentals used by the easings. Defining MICROTWEEN_FAST_MATH
+	// replaces libm with the polynomial approximations from microtween_math.h,
+	// which keep every easing within 3e-7 of the libm result.
+	static float sine(float x)
+	{
+#if defined(MICROTWEEN_FAST_MATH)
+		return microtween_math::sin(x);
+#else
+		return sinf(x);
+#endif
+	}
+
+	static float cosine(float x)
+	{
+#if defined(MICROTWEEN_FAST_MATH)
+		return microtween_math::cos(x);
+#else
+		return cosf(x);
+#endif
+	}
+
+	static float pow2(float x)
+	{
+#if defined(MICROTWEEN_FAST_MATH)
+		return microtween_math::exp2(x);
+#else
+		return powf(2, x);
+#endif
+	}
+
+	static constexpr float pi = 3.141592654f;
+	static constexpr float half_pi = 1.570796327f;
+};
+
+// CSS-style cubic-bezier(x1, y1, x2, y2) easing. x(t) is inverted through a
+// table of t at evenly spaced x, built once per curve, and one Newton step,
+// which keeps the common curves (ease, ease-in-out, back, ...) within 1e-6 of
+// the exact result. Where x(t) is nearly flat, i.e. y is nearly vertical,
+// bisection takes over and the error grows with the steepness. Outside
+// [0, 1] the curve continues along its end tangents. Tweens refer to a curve
+// instead of copying it, so one curve can serve any number of them.
+class microtween_bezier
+{
+public:
+	// x1 and x2 are clamped to [0, 1], which keeps x(t) monotonic.
+	microtween_bezier(float x1, float y1, float x2, float y2)
+	{
+		x1 = std::min(std::max(x1, 0.f), 1.f);
+		x2 = std::min(std::max(x2, 0.f), 1.f);
+		cx = 3 * x1;
+		bx = 3 * (x2 - x1) - cx;
+		ax = 1 - cx - bx;
+		cy = 3 * y1;
+		by = 3 * (y2 - y1) - cy;
+		ay = 1 - cy - by;
+
+		start_slope = x1 > 0 ? y1 / x1 : x2 > 0 ? y2 / x2 : 0;
+		end_slope = x2 < 1 ? (y2 - 1) / (x2 - 1) : x1 < 1 ? (y1 - 1) / (x1 - 1) : 0;
+
+		for (int i = 0; i < size; ++i)
+		{
+			const float x = static_cast<float>(i) / (size - 1);
+			float lo = 0, hi = 1;
+			for (int k = 0; k < 24; ++k)
+			{
+				const float t = (lo + hi) * .5f;
+				if (sample_x(t) < x)
+					lo = t;
+				else
+					hi = t;
+			}
+			table[i] = (lo + hi) * .5f;
+		}
+	}
+
+	float operator()(float x) const
+	{
+		if (!(x > 0.f))
+			return x * start_slope;
+		if (x >= 1.f)
+			return 1 + (x - 1) * end_slope;
+
+		// x lies between two table entries, so t lies between their values.
+		const float f = x * (size - 1);
+		const int i = static_cast<int>(f);
+		float lo = table[i], hi = table[i + 1];
+		float t = lo + (f - i) * (hi - lo);
+		const float d = slope_x(t);
+		if (d > 1e-6f)
+			t = std::min(std::max(t - (sample_x(t) - x) / d, lo), hi);
+
+		// Newton converges slowly where x(t) is flat; bisect there instead.
+		if (std::fabs(sample_x(t) - x) > 5e-7f)
+		{
+			for (int k = 0; k < 24 && hi - lo > 1e-7f; ++k)
+			{
+				t = (lo + hi) * .5f;
+				if (sample_x(t) < x)
+					lo = t;
+				else
+					hi = t;
+			}
+			t = (lo + hi) * .5f;
+		}
+		return sample_y(t);
+	}
+
+private:
+	static const int size = 65;
+
+	// Polynomial coefficients of x(t) and y(t).
+	float ax, bx, cx;
+	float ay, by, cy;
+	float start_slope, end_slope;
+	float table[size];
+
+	float sample_x(float t) const
+	{
+		return ((ax * t + bx) * t + cx) * t;
+	}
+
+	float sample_y(float t) const
+	{
+		return ((ay * t + by) * t + cy) * t;
+	}
+
+	float slope_x(float t) const
+	{
+		return (3 * ax * t + 2 * bx) * t + cx;
+	}
+};
+
+// Damped spring settling from 0 to 1, as an easing. stiffness and damping are
+// per unit mass and velocity is the initial speed in changes per time unit,
+// all in one time unit of the caller's choice (seconds for the usual
+// stiffness 170, damping 26). The motion is solved in closed form, so any t
+// can be evaluated directly with no integration state.
+//
+// A segment shows the motion until it stays within tolerance of the end,
+// which takes duration() time units; give the segment that many ticks to play
+// it at its natural speed. Springs with too little damping to settle within
+// ten periods, undamped ones included, are cut at the first crossing of the
+// end after the tenth period instead, so they finish exactly on it.
+class microtween_spring
+{
+public:
+	microtween_spring(float stiffness, float damping, float velocity = 0, float tolerance = 1e-3f)
+	{
+		// Displacement from the end: x(0) = -1, x'(0) = velocity.
+		const double w = std::sqrt(static_cast<double>(stiffness));
+		const double a = damping * .5;
+		const double v = velocity;
+		const double log2e = 1.4426950408889634;
+
+		if (a < w * .9999)
+		{
+			kind = under;
+			const double wd = std::sqrt(w * w - a * a);
+			const double b = (v - a) / wd;
+			const double pi = 3.141592653589793;
+			const double settle = a > 0 ? std::log(std::sqrt(1 + b * b) / tolerance) / a : HUGE_VAL;
+			if (wd * settle <= 20 * pi)
+			{
+				span = settle;
+			}
+			else
+			{
+				// Crossings are where -cos(wd t) + b sin(wd t) = 0, every pi
+				// of phase from the first.
+				const double first = std::atan2(1., b);
+				span = (first + std::ceil((20 * pi - first) / pi) * pi) / wd;
+			}
+			rate1 = static_cast<float>(-a * span * log2e);
+			omega = static_cast<float>(wd * span);
+			c1 = -1;
+			c2 = static_cast<float>(b);
+		}
+		else if (a <= w * 1.0001)
+		{
+			kind = critical;
+			const double b = v - w;
+			span = std::log(1 / tolerance) / w;
+			for (int i = 0; i < 16; ++i)
+				span = std::log((1 + std::fabs(b) * span) / tolerance) / w;
+			rate1 = static_cast<float>(-w * span * log2e);
+			c1 = -1;
+			c2 = static_cast<float>(b * span);
+		}
+		else
+		{
+			kind = over;
+			const double d = std::sqrt(a * a - w * w);
+			const double r1 = -a + d;
+			const double r2 = -a - d;
+			const double k2 = (v + r1) / (r2 - r1);
+			const double k1 = -1 - k2;
+			span = std::log((std::fabs(k1) + std::fabs(k2)) / tolerance) / -r1;
+			rate1 = static_cast<float>(r1 * span * log2e);
+			rate2 = static_cast<float>(r2 * span * log2e);
+			c1 = static_cast<float>(k1);
+			c2 = static_cast<float>(k2);
+		}
+		if (!(span > 0))
+			span = 1;
+	}
+
+	// Time units the motion takes to settle.
+	float duration() const
+	{
+		return static_cast<float>(span);
+	}
+
+	float operator()(float t) const
+	{
+		return at(t);
+	}
+
+	// The easing at t for a float or any microtween_simd pack. Uses the
+	// approximations from microtween_math.h, which hold for up to about 15
+	// periods.
+	template <class V>
+	V at(V t) const
+	{
+		using microtween_math::select;
+
+		V x;
+		if (kind == under)
+		{
+			const V p = t * omega;
+			x = microtween_math::exp2(t * rate1) * (c1 * microtween_math::cos(p) + c2 * microtween_math::sin(p));
+		}
+		else if (kind == critical)
+		{
+			x = microtween_math::exp2(t * rate1) * (c1 + c2 * t);
+		}
+		else
+		{
+			x = c1 * microtween_math::exp2(t * rate1) + c2 * microtween_math::exp2(t * rate2);
+		}
+		return select(t >= 1.f, V(1.f), select(t <= 0.f, V(0.f), 1.f + x));
+	}
+
+private:
+	enum { under, critical, over } kind;
+	double span;
+	// In time normalized to span: exponential decay rates as powers of two,
+	// angular frequency and the coefficients of the two terms.
+	float rate1 = 0;
+	float rate2 = 0;
+	float omega = 0;
+	float c1 = 0;
+	float c2 = 0;
+};
+
+// Keyframe track: values at increasing key times joined by cubic Hermite
+// pieces, for dense curves such as motion capture. Times, values and tangents
+// sit in three flat arrays, 12 bytes per key. Times passed in are measured
+// from the first key; before it and after the last key the track holds its
+// end values.
+//
+// Lookups start from a hint, normally the piece found last, and walk from
+// there, so playing a track forward costs O(1) per sample. Far jumps fall back
+// to a binary search.
+class microtween_spline
+{
+public:
+	// One Hermite piece in power form, for evaluating many times in it.
+	struct piece
+	{
+		float start;
+		float scale;
+		float p0;
+		float m0;
+		float c;
+		float d;
+
+		// Works on floats and microtween_simd packs.
+		template <class V>
+		V operator()(V time) const
+		{
+			using microtween_math::select;
+
+			V u = (time - start) * scale;
+			u = select(u < 0.f, V(0.f), u);
+			u = select(u > 1.f, V(1.f), u);
+			return ((d * u + c) * u + m0) * u + p0;
+		}
+	};
+
+	// Adds a key after the last one with a Catmull-Rom tangent, the slope
+	// between its neighbours. The tangent is one-sided until the next key is
+	// added.
+	microtween_spline& key(float time, float value)
+	{
+		key(time, value, 0);
+		const std::size_t n = times.size() - 1;
+		tangents[n] = n ? slope(n - 1, n) : 0;
+		automatic = true;
+		return *this;
+	}
+
+	// Adds a key after the last one with tangent in change of value per tick.
+	microtween_spline& key(float time, float value, float tangent)
+	{
+		const std::size_t n = times.size();
+		times.push_back(time);
+		values.push_back(value);
+		tangents.push_back(tangent);
+		if (n && automatic)
+			tangents[n - 1] = slope(n > 1 ? n - 2 : 0, n);
+		automatic = false;
+		return *this;
+	}
+
+	void reserve(std::size_t n)
+	{
+		times.reserve(n);
+		values.reserve(n);
+		tangents.reserve(n);
+	}
+
+	void clear()
+	{
+		times.clear();
+		values.clear();
+		tangents.clear();
+		automatic = false;
+	}
+
+	// Number of keys.
+	std::size_t size() const
+	{
+		return times.size();
+	}
+
+	// Time from the first key to the last.
+	float duration() const
+	{
+		return times.empty() ? 0.f : times.back() - times.front();
+	}
+
+	// Index of the piece holding time, pieces being numbered by their first
+	// key, searching from hint.
+	std::size_t find(float time, std::size_t hint = 0) const
+	{
+		if (times.size() < 3)
+			return 0;
+
+		const float* t = times.data();
+		const std::size_t last = times.size() - 2;
+		time += t[0];
+		std::size_t i = std::min(hint, last);
+		if (t[i] <= time)
+		{
+			for (int k = 0; k < 4 && i < last && t[i + 1] <= time; ++k)
+				++i;
+			if (i < last && t[i + 1] <= time)
+				i = std::upper_bound(t + i + 1, t + last + 1, time) - t - 1;
+		}
+		else if (i > 0 && t[i - 1] <= time)
+		{
+			--i;
+		}
+		else
+		{
+			i = std::upper_bound(t, t + i, time) - t;
+			i = i ? i - 1 : 0;
+		}
+		return i;
+	}
+
+	piece at(std::size_t i) const
+	{
+		if (times.size() < 2)
+		{
+			const float v = values.empty() ? 0.f : values[0];
+			return { 0, 0, v, 0, 0, 0 };
+		}
+
+		const float h = times[i + 1] - times[i];
+		const float p0 = values[i];
+		const float p1 = values[i + 1];
+		const float m0 = tangents[i] * h;
+		const float m1 = tangents[i + 1] * h;
+		return { times[i] - times[0], h > 0 ? 1 / h : 0.f, p0, m0, 3 * (p1 - p0) - 2 * m0 - m1, 2 * (p0 - p1) + m0 + m1 };
+	}
+
+	float operator()(float time, std::size_t hint = 0) const
+	{
+		return at(find(time, hint))(time);
+	}
+
+	// Calls f(p, k, m) for each run of samples k .. m - 1 taken at t0 + k * dt
+	// that fall into the same piece p, in order. dt must not be negative.
+	template <class F>
+	void runs(float t0, float dt, int n, F&& f, std::size_t hint = 0) const
+	{
+		const std::size_t last = times.size() < 2 ? 0 : times.size() - 2;
+		std::size_t i = hint;
+		for (int k = 0; k < n;)
+		{
+			i = find(t0 + k * dt, i);
+			int m = n;
+			if (i < last)
+			{
+				const float end = times[i + 1] - times[0];
+				m = k + 1;
+				while (m < n && t0 + m * dt < end)
+					++m;
+			}
+			f(at(i), k, m);
+			k = m;
+		}
+	}
+
+	// Writes the track at t0, t0 + dt, t0 + 2 * dt, ... to out. Each piece is
+	// set up once and its samples are evaluated in a branch-free loop.
+	void sample(float t0, float dt, int n, float* out, std::size_t hint = 0) const
+	{
+		runs(t0, dt, n, [t0, dt, out](const piece& p, int k, int m)
+		{
+			for (int j = k; j < m; ++j)
+				out[j] = p(t0 + j * dt);
+		}, hint);
+	}
+
+private:
+	std::vector<float> times;
+	std::vector<float> values;
+	std::vector<float> tangents;
+	// Whether the last key's tangent is still to be smoothed.
+	bool automatic = false;
+
+	float slope(std::size_t a, std::size_t b) const
+	{
+		const float h = times[b] - times[a];
+		return h > 0 ? (values[b] - values[a]) / h : 0.f;
+	}
+};
+
+// A sequence of eased segments over values of type T. The easing is evaluated
+// once per sample and applied to the whole value through
+// microtween_traits<T>::lerp, so a vector animates as one tween. All storage
+// comes from Alloc (rebound as needed), e.g. microtween_arena_allocator. The
+// first Inline segments are stored inside the object, so short tweens never
+// allocate.
+template <class T = float, class Alloc = std::allocator<T>, std::size_t Inline = 4>
+class basic_microtween : public microtween_base
+{
+	template <class U>
+	using allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
+
+	template <class U>
+	using vector = std::vector<U, allocator<U>>;
+
+	template <class U>
+	using small_vector = microtween_small_vector<U, Inline, allocator<U>>;
+
+public:
+	typedef T value_type;
+	typedef Alloc allocator_type;
+
+	explicit basic_microtween(const Alloc& a = Alloc()) : sequence(a), starts(a), hooks(a), curves(a), splines(a) {}
+
+	basic_microtween& reset(const T& v)
+	{
+		sequence.clear();
+		starts.clear();
+		hooks.clear();
+		curves.clear();
+		splines.clear();
+		from_value = v;
+		cursor = 0;
+		position = 0;
+		total = 0;
+		repeats = 0;
+		mirror = false;
+		active = 0;
+		active_start = 0;
+		active_from = v;
+		next_hook = 0;
+		key = 0;
+		return *this;
+	}
+
+	basic_microtween& reset(int v)
+	{
+		return reset(static_cast<T>(v));
+	}
+
+	basic_microtween& to(const T& end, int d, easing e = easing::linear)
+	{
+		sequence.emplace_back(end, d, e);
+		starts.push_back(total);
+		total += d;
+		track();
+		return *this;
+	}
+
+	basic_microtween& to(int end, int d, easing e = easing::linear)
+	{
+		return to(static_cast<T>(end), d, e);
+	}
+
+	// Segment eased by b, which must outlive the tween.
+	basic_microtween& to(const T& end, int d, const microtween_bezier& b)
+	{
+		return to_curve(end, d, make_curve(b));
+	}
+
+	basic_microtween& to(int end, int d, const microtween_bezier& b)
+	{
+		return to(static_cast<T>(end), d, b);
+	}
+
+	// Segment moved by the spring s, which must outlive the tween.
+	basic_microtween& to(const T& end, int d, const microtween_spring& s)
+	{
+		return to_curve(end, d, make_curve(s));
+	}
+
+	basic_microtween& to(int end, int d, const microtween_spring& s)
+	{
+		return to(static_cast<T>(end), d, s);
+	}
+
+	// Segment playing the keys of s, which must outlive the tween, from its
+	// first key on for its duration() rounded up to whole ticks. Only for
+	// value types convertible from float.
+	template <class U = T, class = typename std::enable_if<std::is_convertible<float, U>::value>::type>
+	basic_microtween& to(const microtween_spline& s)
+	{
+		if (splines.empty() || splines.back() != &s)
+			splines.push_back(&s);
+		const int d = static_cast<int>(std::ceil(s.duration()));
+		sequence.emplace_back(static_cast<T>(s(s.duration())), d, easing::linear);
+		sequence.back().keyed = true;
+		sequence.back().curve = static_cast<std::uint16_t>(splines.size());
+		starts.push_back(total);
+		total += d;
+		track();
+		return *this;
+	}
+
+	basic_microtween& wait(int d)
+	{
+		T end = from_value;
+		if (!sequence.empty())
+			end = sequence.back().end;
+		return to(end, d);
+	}
+
+	// Evaluates easings through l instead of interpolate(); nullptr switches
+	// back to exact evaluation. l must outlive the tween.
+	basic_microtween& lut(const microtween_lut* l)
+	{
+		easing_lut = l;
+		return *this;
+	}
+
+	// Calls cb when the last segment ends, replacing its callback; an empty
+	// cb removes it.
+	basic_microtween& call(const cb_t& cb)
+	{
+		const std::size_t i = sequence.size() - 1;
+		const bool set = !hooks.empty() && hooks.back().segment == i;
+		if (!cb)
+		{
+			if (set)
+				hooks.pop_back();
+			next_hook = std::min(next_hook, hooks.size());
+		}
+		else if (set)
+		{
+			hooks.back().cb = cb;
+		}
+		else
+		{
+			hooks.push_back({ i, cb });
+		}
+		return *this;
+	}
+
+	// Plays the sequence count more times after the first, or forever if count
+	// is negative. With yoyo every other pass plays backwards. Passes reuse the
+	// segments, so looping costs no memory.
+	basic_microtween& repeat(int count = -1, bool yoyo = false)
+	{
+		repeats = count < 0 ? -1 : count;
+		mirror = yoyo;
+		track();
+		return *this;
+	}
+
+	// Advances the cursor by s ticks. s may be fractional, e.g. the frame time
+	// when durations are given in milliseconds.
+	// Callbacks of all segments ending in (cursor, cursor + s] fire in order,
+	// each with the cursor at the end of its segment. Only the segments
+	// crossed are walked. A repeating tween fires them on every pass; a
+	// backwards pass crosses the segment ends in reverse order.
+	void step(double s = 1)
+	{
+		const double c = cursor + s;
+		if (repeats == 0)
+			cross(c, 0);
+		else if (s > 0 && !hooks.empty() && total > 0)
+			loop(c);
+
+		cursor = c;
+		track();
+	}
+
+	T get() const
+	{
+		if (active < sequence.size())
+			return sample(active, active_start, active_from, position, key);
+		return at(position);
+	}
+
+	T get(double c) const
+	{
+		return at(map(c));
+	}
+
+	// Writes count samples taken at c0, c0 + stride, c0 + 2 * stride, ... to out.
+	// Segments are walked once, so this is much cheaper than calling get(c)
+	// per sample.
+	void get_range(int c0, int count, int stride, T* out) const
+	{
+		if (sequence.empty() || stride <= 0 || repeats != 0)
+		{
+			for (int k = 0; k < count; ++k)
+				out[k] = get(c0 + k * stride);
+			return;
+		}
+
+		int k = 0;
+		int c = c0;
+		std::size_t i = find(c);
+		while (k < count && c < total)
+		{
+			while (c >= starts[i] + sequence[i].duration)
+				++i;
+
+			const tween_point& p = sequence[i];
+			const T& start = i ? sequence[i - 1].end : from_value;
+			const int n = std::min(count - k, (starts[i] + p.duration - c + stride - 1) / stride);
+			if (p.keyed)
+			{
+				fill_keys(*splines[p.curve - 1], static_cast<float>(c - starts[i]), static_cast<float>(stride), n, out + k);
+			}
+			else if (easing_lut || p.curve)
+			{
+				for (int j = 0; j < n; ++j)
+					out[k + j] = traits::lerp(start, p.end, shape(p, static_cast<float>(c + j * stride - starts[i]) * p.inv_duration));
+			}
+			else
+			{
+				filler(p.easing)(start, p.end, starts[i], p.inv_duration, c, stride, n, out + k);
+			}
+			k += n;
+			c += n * stride;
+		}
+
+		const T& end = sequence.back().end;
+		for (; k < count; ++k)
+			out[k] = end;
+	}
+
+	int geti(double c) const
+	{
+		return static_cast<int>(roundf(get(c)));
+	}
+
+	int geti() const
+	{
+		return geti(cursor);
+	}
+
+	// Length of all passes; INT_MAX when repeating forever.
+	int duration() const
+	{
+		if (repeats < 0)
+			return total > 0 ? INT_MAX : 0;
+		const long long d = static_cast<long long>(total) * (repeats + 1);
+		return d < INT_MAX ? static_cast<int>(d) : INT_MAX;
+	}
+
+	bool finished() const
+	{
+		if (repeats < 0)
+			return total <= 0;
+		return cursor >= duration();
+	}
+
+private:
+	friend class microtween_pool;
+	friend class microtween_binary_writer;
+	friend class microtween_packed;
+
+	typedef microtween_traits<T> traits;
+
+	struct tween_point
+	{
+		tween_point(const T& end, int duration, easing easing) : end(end),
+			duration(duration), inv_duration(duration ? 1.f / duration : 0.f), easing(easing) {}
+		T end;
+		int duration;
+		float inv_duration;
+		easing easing;
+		// Whether the segment plays a spline instead of easing to end.
+		bool keyed = false;
+		// 1 + index into curves (splines if keyed), or 0 to use easing.
+		std::uint16_t curve = 0;
+	};
+
+	// Callbacks live apart from the segments to keep those small, ordered by
+	// the segment whose end calls them.
+	struct hook
+	{
+		std::size_t segment;
+		cb_t cb;
+	};
+
+	T from_value = T();
+	double cursor = 0;
+	// Cursor mapped into one pass, which the cache below follows.
+	double position = 0;
+	// Length of one pass.
+	int total = 0;
+	// Passes after the first (-1 forever), and whether odd ones run backwards.
+	int repeats = 0;
+	bool mirror = false;
+	small_vector<tween_point> sequence;
+	// starts[i] is the time at which sequence[i] begins, so the segment
+	// containing a given time can be found with a binary search.
+	small_vector<int> starts;
+	vector<hook> hooks;
+	// Curves of the segments that have one, at most 65535; consecutive
+	// segments with the same curve share an entry.
+	vector<curve> curves;
+	// Splines of the keyed segments, shared the same way.
+	vector<const microtween_spline*> splines;
+
+	// Cached segment containing position (sequence.size() once past the end),
+	// with its start time and start value. Kept up to date by step(), so
+	// playing forward never searches the sequence.
+	std::size_t active = 0;
+	int active_start = 0;
+	T active_from = T();
+	// First hook at or after the active segment.
+	std::size_t next_hook = 0;
+	// Piece of the active segment's spline holding position, if it has one.
+	std::size_t key = 0;
+
+	const microtween_lut* easing_lut = nullptr;
+	float eval(float t, easing e) const;
+
+	void track()
+	{
+		position = map(cursor);
+		if (active > 0 && position < active_start)
+		{
+			active = find(position);
+			active_start = starts[active];
+			active_from = active ? sequence[active - 1].end : from_value;
+			next_hook = std::lower_bound(hooks.begin(), hooks.end(), active,
+				[](const hook& h, std::size_t i) { return h.segment < i; }) - hooks.begin();
+		}
+
+		while (active < sequence.size() && position >= active_start + sequence[active].duration)
+		{
+			active_start += sequence[active].duration;
+			active_from = sequence[active].end;
+			++active;
+		}
+
+		while (next_hook < hooks.size() && hooks[next_hook].segment < active)
+			++next_hook;
+
+		if (active < sequence.size() && sequence[active].keyed)
+			key = splines[sequence[active].curve - 1]->find(static_cast<float>(position - active_start), key);
+	}
+
+	// Time c mapped into one pass. Times before the first pass are left alone;
+	// times after the last one map to where it ends.
+	double map(double c) const
+	{
+		if (repeats == 0 || total <= 0 || c < 0)
+			return c;
+
+		const double n = std::floor(c / total);
+		if (repeats > 0 && n > repeats)
+			return mirror && repeats % 2 ? 0 : total;
+
+		const double l = c - n * total;
+		return mirror && std::fmod(n, 2.) != 0 ? total - l : l;
+	}
+
+	// Moves the cache forwards to time to of a forward pass starting at base,
+	// calling the callbacks of the segments it leaves.
+	void cross(double to, double base)
+	{
+		while (active < sequence.size() && to >= active_start + sequence[active].duration)
+		{
+			const std::size_t i = active++;
+			active_start += sequence[i].duration;
+			active_from = sequence[i].end;
+			if (next_hook < hooks.size() && hooks[next_hook].segment == i)
+			{
+				cursor = base + active_start;
+				position = active_start;
+				hooks[next_hook++].cb();
+			}
+		}
+	}
+
+	// Moves the cache backwards to time to of a backward pass starting at
+	// base, calling the callbacks of the segment ends it passes.
+	void uncross(double to, double base)
+	{
+		const double from = position;
+		while (active > 0 && active_start >= to)
+		{
+			const int end = active_start;
+			--active;
+			active_start -= sequence[active].duration;
+			active_from = active ? sequence[active - 1].end : from_value;
+			if (next_hook > 0 && hooks[next_hook - 1].segment == active)
+			{
+				--next_hook;
+				if (end < from)
+				{
+					cursor = base + total - end;
+					position = end;
+					hooks[next_hook].cb();
+				}
+			}
+		}
+	}
+
+	// Steps a repeating tween to c one pass at a time.
+	void loop(double c)
+	{
+		for (;;)
+		{
+			double n = cursor < 0 ? 0 : std::floor(cursor / total);
+			if (repeats > 0 && n > repeats)
+				n = repeats;
+			const double base = n * total;
+			const bool backwards = mirror && std::fmod(n, 2.) != 0;
+
+			if (n == repeats || c < base + total)
+			{
+				if (backwards)
+					uncross(total - (c - base), base);
+				else
+					cross(c - base, base);
+				return;
+			}
+
+			if (backwards)
+				uncross(0, base);
+			else
+				cross(total, base);
+			cursor = base + total;
+			track();
+		}
+	}
+
+	typedef void (*fill_fn)(const T& start, const T& end, int start_time, float inv_duration, int c, int stride, int n, T* out);
+	static fill_fn filler(easing e);
+
+	template <easing E>
+	static void fill(const T& start, const T& end, int start_time, float inv_duration, int c, int stride, int n, T* out)
+	{
+		for (int k = 0; k < n; ++k, c += stride)
+			out[k] = traits::lerp(start, end, ease<E>(static_cast<float>(c - start_time) * inv_duration));
+	}
+
+	basic_microtween& to_curve(const T& end, int d, const curve& c)
+	{
+		if (curves.empty() || curves.back().object != c.object || curves.back().fn != c.fn)
+			curves.push_back(c);
+		sequence.emplace_back(end, d, easing::linear);
+		sequence.back().curve = static_cast<std::uint16_t>(curves.size());
+		starts.push_back(total);
+		total += d;
+		track();
+		return *this;
+	}
+
+	float shape(const tween_point& p, float t) const
+	{
+		return p.curve ? curves[p.curve - 1](t) : eval(t, p.easing);
+	}
+
+	// Value at time c of one pass.
+	T at(double c) const
+	{
+		if (sequence.empty())
+			return from_value;
+
+		if (c >= total)
+			return sequence.back().end;
+
+		if (active < sequence.size() && c >= active_start && c < active_start + sequence[active].duration)
+			return sample(active, active_start, active_from, c, key);
+
+		const std::size_t i = find(c);
+		return sample(i, starts[i], i ? sequence[i - 1].end : from_value, c);
+	}
+
+	T sample(std::size_t i, int start_time, const T& start, double c, std::size_t hint = 0) const
+	{
+		const tween_point& p = sequence[i];
+		if (p.keyed)
+			return from_key((*splines[p.curve - 1])(static_cast<float>(c - start_time), hint), std::is_convertible<float, T>());
+		return traits::lerp(start, p.end, shape(p, static_cast<float>(c - start_time) * p.inv_duration));
+	}
+
+	static T from_key(float v, std::true_type)
+	{
+		return static_cast<T>(v);
+	}
+
+	static T from_key(float, std::false_type)
+	{
+		return T();
+	}
+
+	static void fill_keys(const microtween_spline& s, float t0, float dt, int n, float* out)
+	{
+		s.sample(t0, dt, n, out);
+	}
+
+	template <class U>
+	static void fill_keys(const microtween_spline& s, float t0, float dt, int n, U* out)
+	{
+		s.runs(t0, dt, n, [t0, dt, out](const microtween_spline::piece& p, int k, int m)
+		{
+			for (int j = k; j < m; ++j)
+				out[j] = from_key(p(t0 + j * dt), std::is_convertible<float, T>());
+		});
+	}
+
+	// Index of the last segment starting at or before c (zero-length segments
+	// are skipped because a following segment shares their start time).
+	// Times before the first segment map to the first one.
+	std::size_t find(double c) const
+	{
+		const auto it = std::upper_bound(starts.begin(), starts.end(), c);
+		return it == starts.begin() ? 0 : static_cast<std::size_t>(it - starts.begin()) - 1;
+	}
+};
+
+typedef basic_microtween<float> microtween;
+typedef basic_microtween<std::array<float, 2>> microtween2;
+typedef basic_microtween<std::array<float, 3>> microtween3;
+typedef basic_microtween<std::array<float, 4>> microtween4;
+
+// Easings baked into tables of resolution entries over [0, 1], at least 2, and
+// sampled with linear interpolation. Memory is 28 * resolution floats (28 KB at 256, 112 KB
+// at 1024, 448 KB at 4096).
+//
+// Maximum absolute error of the smooth easings (all but circular_*,
+// elastic_* and quintic_in_out), reached by exponential_in_out:
+//   256 entries  - 1.8e-4
+//   1024 entries - 1.2e-5
+//   4096 entries - 7.5e-7
+// circular_* have infinite slope at an end point (1.1e-2 at 1024 entries)
+// and quintic_in_out jumps at 0.5. elastic_* are cut to 0 and 1 near the
+// ends, so from 1024 entries on their error barely shrinks: 6.8e-3 for
+// elastic_in, 4.6e-4 for elastic_out and 9.7e-5 for elastic_in_out. The
+// error of each easing is measured while baking, at 15 points per entry and
+// on both sides of the cuts, and easings above max_error are evaluated
+// exactly instead; with the defaults that is circular_*, elastic_in,
+// elastic_out and quintic_in_out. So are values of t outside [0, 1].
+class microtween_lut
+{
+public:
+	explicit microtween_lut(int resolution = 1024, float max_error = 1e-4f) : resolution(std::max(resolution, 2)),
+		scale(static_cast<float>(this->resolution - 1)), values(count * this->resolution), errors(count)
+	{
+		bake(max_error);
+	}
+
+	float operator()(float t, microtween_base::easing e) const
+	{
+		const int k = static_cast<int>(e);
+		if (errors[k] < 0 || !(t >= 0.f && t <= 1.f))
+			return microtween_base::interpolate(t, e);
+
+		const float x = t * scale;
+		const int i = std::min(static_cast<int>(x), resolution - 2);
+		const float* v = &values[k * resolution + i];
+		return v[0] + (x - i) * (v[1] - v[0]);
+	}
+
+	// Error of e measured while baking, or -1 if e is evaluated exactly.
+	float error(microtween_base::easing e) const
+	{
+		return errors[static_cast<int>(e)];
+	}
+
+private:
+	static const int count = static_cast<int>(microtween_base::easing::back_in_out) + 1;
+
+	int resolution;
+	float scale;
+	std::vector<float> values;
+	std::vector<float> errors;
+
+	void bake(float max_error)
+	{
+		// Where elastic_* are cut to 0 and 1; the jumps fall between samples.
+		static const float cuts[] = { 0.00001f, 0.999f };
+
+		for (int e = 0; e < count; ++e)
+		{
+			const microtween_base::easing k = static_cast<microtween_base::easing>(e);
+			const microtween_base::ease_fn f = microtween_base::easer(k);
+			float* v = &values[e * resolution];
+			for (int i = 0; i < resolution; ++i)
+				v[i] = f(i / scale);
+
+			errors[e] = 0;
+			float error = 0;
+			for (int i = 0; i + 1 < resolution; ++i)
+				for (int q = 1; q < 16; ++q)
+					error = std::max(error, deviation((i + q / 16.f) / scale, k));
+			for (float c : cuts)
+			{
+				error = std::max(error, deviation(std::nextafter(c, 0.f), k));
+				error = std::max(error, deviation(c, k));
+			}
+			// Peaks between the points measured are at most about 1% higher;
+			// two float steps more cover rounding.
+			error = error * 1.01f + 2 * std::numeric_limits<float>::epsilon();
+			errors[e] = error <= max_error ? error : -1.f;
+		}
+	}
+
+	// Difference between the table and the easing at t.
+	float deviation(float t, microtween_base::easing e) const
+	{
+		return std::fabs((*this)(t, e) - microtween_base::interpolate(t, e));
+	}
+};
+
+template <class T, class Alloc, std::size_t Inline>
+inline float basic_microtween<T, Alloc, Inline>::eval(float t, easing e) const
+{
+	return easing_lut ? (*easing_lut)(t, e) : interpolate(t, e);
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::linear>(float t)
+{
+	return t;
+}
+
+template <>
+inline float microtween_base::ease<microtween_base::easing::sine_in>(float t)
+{
+	return 1.f + sine(half_pi * (t - 1.0f));
+}
+
+template <>
+inline float microtween_base::ease<microtween_base::easing::sine_out>(float t)
+{
+	return sine(half_pi * t);
+}
+
+template <>
+inline float microtween_base::ease<microtween_base::easing::sine_in_out>(float t)
+{
+	return .5f * (1.f - cosine(t * pi));
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::quadratic_in>(float t)
+{
+	return t * t;
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::quadratic_out>(float t)
+{
+	return -1.f * t * (t - 2);
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::quadratic_in_out>(float t)
+{
+	t *= 2;
+	if (t < 1)
+		return .5f * t * t;
+	--t;
+	return -.5f * (t * (t - 2) - 1);
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::cubic_in>(float t)
+{
+	return t * t * t;
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::cubic_out>(float t)
+{
+	--t;
+	return t * t * t + 1;
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::cubic_in_out>(float t)
+{
+	t *= 2;
+	if (t < 1)
+		return .5f * t * t * t;
+	t -= 2;
+	return .5f * (t * t * t + 2);
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::quartic_in>(float t)
+{
+	return t * t * t * t;
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::quartic_out>(float t)
+{
+	--t;
+	return -(t * t * t * t - 1);
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::quartic_in_out>(float t)
+{
+	t *= 2;
+	if (t < 1)
+		return .5f * (t * t * t * t);
+	t -= 2;
+	return -.5f * (t * t * t * t - 2);
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::quintic_in>(float t)
+{
+	return t * t * t * t * t;
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::quintic_out>(float t)
+{
+	--t;
+	return 1.f + t * t * t * t * t;
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::quintic_in_out>(float t)
+{
+	if (t < .5f)
+		return 16.f * t * t * t * t * t;
+
+	--t;
+	return 1.f - 16.f * t * t * t * t * t;
+}
+
+template <>
+inline float microtween_base::ease<microtween_base::easing::exponential_in>(float t)
+{
+	return pow2(10 * (t - 1));
+}
+
+template <>
+inline float microtween_base::ease<microtween_base::easing::exponential_out>(float t)
+{
+	return -pow2(-10 * t) + 1;
+}
+
+template <>
+inline float microtween_base::ease<microtween_base::easing::exponential_in_out>(float t)
+{
+	t *= 2;
+	if (t < 1)
+		return .5f * pow2(10 * (t - 1));
+	--t;
+	return .5f * (-pow2(-10 * t) + 2);
+}
+
+template <>
+inline float microtween_base::ease<microtween_base::easing::circular_in>(float t)
+{
+	return -(sqrtf(1 - t * t) - 1);
+}
+
+template <>
+inline float microtween_base::ease<microtween_base::easing::circular_out>(float t)
+{
+	--t;
+	return sqrtf(1 - t * t);
+}
+
+template <>
+inline float microtween_base::ease<microtween_base::easing::circular_in_out>(float t)
+{
+	t *= 2;
+	if (t < 1)
+		return -.5f * (sqrtf(1 - t * t) - 1);
+	t -= 2;
+	return .5f * (sqrtf(1 - t * t) + 1);
+}
+
+template <>
+inline float microtween_base::ease<microtween_base::easing::elastic_in>(float t)
+{
+	if (t <= 0.00001f)
+		return 0.f;
+	if (t >= 0.999f)
+		return 1.f;
+	float p = .3f;
+	float s = p / 4;
+	float postFix = pow2(10 * (t -= 1)); // this is a fix, again, with post-increment operators
+	return -(postFix * sine((t - s) * (2 * static_cast<float>(pi)) / p));
+}
+
+template <>
+inline float microtween_base::ease<microtween_base::easing::elastic_out>(float t)
+{
+	if (t <= 0.00001f)
+		return 0.f;
+	if (t >= 0.999f)
+		return 1.f;
+	float p = .3f;
+	float s = p / 4;
+	return pow2(-10 * t) * sine((t - s) * (2 * static_cast<float>(pi)) / p) + 1.f;
+}
+
+template <>
+inline float microtween_base::ease<microtween_base::easing::elastic_in_out>(float t)
+{
+	if (t <= 0.00001f)
+		return 0.f;
+	if (t >= 0.999f)
+		return 1.f;
+	t *= 2;
+	float p = (.3f * 1.5f);
+	float s = p / 4;
+	float postFix;
+	if (t < 1)
+	{
+		postFix = pow2(10 * (t -= 1));
+		return -0.5f * (postFix * sine((t - s) * (2 * static_cast<float>(pi)) / p));
+	}
+	postFix = pow2(-10 * (t -= 1));
+	return postFix * sine((t - s) * (2 * static_cast<float>(pi)) / p) * .5f + 1.f;
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::back_in>(float t)
+{
+	float s = 1.70158f;
+	return t * t * ((s + 1) * t - s);
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::back_out>(float t)
+{
+	float s = 1.70158f;
+	t -= 1;
+	return t * t * ((s + 1) * t + s) + 1;
+}
+
+template <>
+constexpr float microtween_base::ease<microtween_base::easing::back_in_out>(float t)
+{
+	float s = 1.70158f * 1.525f;
+	if ((t /= .5f) < 1)
+		return .5f * (t * t * ((s + 1) * t - s));
+	float p = t -= 2;
+	return .5f * (p * t * ((s + 1) * t + s) + 2);
+}
+
+// Indexed by easing, in declaration order.
+inline microtween_base::ease_fn microtween_base::easer(easing e)
+{
+	static const ease_fn table[] = {
+		&ease<easing::linear>,
+		&ease<easing::sine_in>,
+		&ease<easing::sine_out>,
+		&ease<easing::sine_in_out>,
+		&ease<easing::quadratic_in>,
+		&ease<easing::quadratic_out>,
+		&ease<easing::quadratic_in_out>,
+		&ease<easing::cubic_in>,
+		&ease<easing::cubic_out>,
+		&ease<easing::cubic_in_out>,
+		&ease<easing::quartic_in>,
+		&ease<easing::quartic_out>,
+		&ease<easing::quartic_in_out>,
+		&ease<easing::quintic_in>,
+		&ease<easing::quintic_out>,
+		&ease<easing::quintic_in_out>,
+		&ease<easing::exponential_in>,
+		&ease<easing::exponential_out>,
+		&ease<easing::exponential_in_out>,
+		&ease<easing::circular_in>,
+		&ease<easing::circular_out>,
+		&ease<easing::circular_in_out>,
+		&ease<easing::elastic_in>,
+		&ease<easing::elastic_out>,
+		&ease<easing::elastic_in_out>,
+		&ease<easing::back_in>,
+		&ease<easing::back_out>,
+		&ease<easing::back_in_out>
+	};
+	return table[static_cast<int>(e)];
+}
+
+template <class T, class Alloc, std::size_t Inline>
+inline typename basic_microtween<T, Alloc, Inline>::fill_fn basic_microtween<T, Alloc, Inline>::filler(easing e)
+{
+	static const fill_fn table[] = {
+		&fill<easing::linear>,
+		&fill<easing::sine_in>,
+		&fill<easing::sine_out>,
+		&fill<easing::sine_in_out>,
+		&fill<easing::quadratic_in>,
+		&fill<easing::quadratic_out>,
+		&fill<easing::quadratic_in_out>,
+		&fill<easing::cubic_in>,
+		&fill<easing::cubic_out>,
+		&fill<easing::cubic_in_out>,
+		&fill<easing::quartic_in>,
+		&fill<easing::quartic_out>,
+		&fill<easing::quartic_in_out>,
+		&fill<easing::quintic_in>,
+		&fill<easing::quintic_out>,
+		&fill<easing::quintic_in_out>,
+		&fill<easing::exponential_in>,
+		&fill<easing::exponential_out>,
+		&fill<easing::exponential_in_out>,
+		&fill<easing::circular_in>,
+		&fill<easing::circular_out>,
+		&fill<easing::circular_in_out>,
+		&fill<easing::elastic_in>,
+		&fill<easing::elastic_out>,
+		&fill<easing::elastic_in_out>,
+		&fill<easing::back_in>,
+		&fill<easing::back_out>,
+		&fill<easing::back_in_out>
+	};
+	return table[static_cast<int>(e)];
+}
+
+inline float microtween_base::interpolate(float t, easing e)
+{
+	switch (e)
+	{
+	case easing::linear:
+		return ease<easing::linear>(t);
+	case easing::sine_in:
+		return ease<easing::sine_in>(t);
+	case easing::sine_out:
+		return ease<easing::sine_out>(t);
+	case easing::sine_in_out:
+		return ease<easing::sine_in_out>(t);
+	case easing::quadratic_in:
+		return ease<easing::quadratic_in>(t);
+	case easing::quadratic_out:
+		return ease<easing::quadratic_out>(t);
+	case easing::quadratic_in_out:
+		return ease<easing::quadratic_in_out>(t);
+	case easing::cubic_in:
+		return ease<easing::cubic_in>(t);
+	case easing::cubic_out:
+		return ease<easing::cubic_out>(t);
+	case easing::cubic_in_out:
+		return ease<easing::cubic_in_out>(t);
+	case easing::quartic_in:
+		return ease<easing::quartic_in>(t);
+	case easing::quartic_out:
+		return ease<easing::quartic_out>(t);
+	case easing::quartic_in_out:
+		return ease<easing::quartic_in_out>(t);
+	case easing::quintic_in:
+		return ease<easing::quintic_in>(t);
+	case easing::quintic_out:
+		return ease<easing::quintic_out>(t);
+	case easing::quintic_in_out:
+		return ease<easing::quintic_in_out>(t);
+	case easing::exponential_in:
+		return ease<easing::exponential_in>(t);
+	case easing::exponential_out:
+		return ease<easing::exponential_out>(t);
+	case easing::exponential_in_out:
+		return ease<easing::exponential_in_out>(t);
+	case easing::circular_in:
+		return ease<easing::circular_in>(t);
+	case easing::circular_out:
+		return ease<easing::circular_out>(t);
+	case easing::circular_in_out:
+		return ease<easing::circular_in_out>(t);
+	case easing::elastic_in:
+		return ease<easing::elastic_in>(t);
+	case easing::elastic_out:
+		return ease<easing::elastic_out>(t);
+	case easing::elastic_in_out:
+		return ease<easing::elastic_in_out>(t);
+	case easing::back_in:
+		return ease<easing::back_in>(t);
+	case easing::back_out:
+		return ease<easing::back_out>(t);
+	case easing::back_in_out:
+		return ease<easing::back_in_out>(t);
+	}
+	return t;
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// Bump allocator for tweens that are created and dropped together, e.g. all
+// tweens of a UI burst or a scene. Individual frees are no-ops; release()
+// drops everything at once and keeps one block for reuse, so steady-state
+// use never reaches the global heap.
+//
+// Containers grown one element at a time leave their old buffers behind
+// until release(); reserve up front where the size is known.
+class microtween_arena
+{
+public:
+	explicit microtween_arena(std::size_t block_size = 64 * 1024) : block_size(block_size) {}
+
+	microtween_arena(const microtween_arena&) = delete;
+	microtween_arena& operator=(const microtween_arena&) = delete;
+
+	~microtween_arena()
+	{
+		while (head)
+		{
+			block* prev = head->prev;
+			::operator delete(head);
+			head = prev;
+		}
+	}
+
+	void* allocate(std::size_t n, std::size_t align)
+	{
+		std::size_t at = (offset + align - 1) & ~(align - 1);
+		if (!head || at + n > head->size)
+		{
+			grow(n + align);
+			at = (offset + align - 1) & ~(align - 1);
+		}
+		offset = at + n;
+		return reinterpret_cast<char*>(head) + at;
+	}
+
+	// Frees everything allocated so far. Nothing allocated from the arena may
+	// be used afterwards.
+	void release()
+	{
+		while (head && head->prev)
+		{
+			block* prev = head->prev;
+			::operator delete(head);
+			head = prev;
+		}
+		offset = sizeof(block);
+	}
+
+private:
+	struct block
+	{
+		block* prev;
+		std::size_t size;
+	};
+
+	std::size_t block_size;
+	block* head = nullptr;
+	std::size_t offset = sizeof(block);
+
+	void grow(std::size_t n)
+	{
+		const std::size_t size = sizeof(block) + (n > block_size ? n : block_size);
+		block* b = static_cast<block*>(::operator new(size));
+		b->prev = head;
+		b->size = size;
+		head = b;
+		offset = sizeof(block);
+	}
+};
+
+// Standard allocator drawing from a microtween_arena, for
+// basic_microtween<T, microtween_arena_allocator<T>>.
+template <class T>
+class microtween_arena_allocator
+{
+public:
+	typedef T value_type;
+
+	explicit microtween_arena_allocator(microtween_arena& arena) : arena(&arena) {}
+
+	template <class U>
+	microtween_arena_allocator(const microtween_arena_allocator<U>& other) : arena(other.arena) {}
+
+	T* allocate(std::size_t n)
+	{
+		return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T*, std::size_t) {}
+
+	template <class U>
+	bool operator==(const microtween_arena_allocator<U>& other) const
+	{
+		return arena == other.arena;
+	}
+
+	template <class U>
+	bool operator!=(const microtween_arena_allocator<U>& other) const
+	{
+		return arena != other.arena;
+	}
+
+private:
+	template <class U>
+	friend class microtween_arena_allocator;
+
+	microtween_arena* arena;
+};
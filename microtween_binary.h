@@ -0,0 +1,243 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "microtween.h"
+
+// Binary form of a library of float sequences: from value, segment ends,
+// timing and easing ids. It holds no pointers, so a file can be memory-mapped
+// and its sequences evaluated in place, with nothing allocated per segment.
+//
+// All fields are 4-byte words in host byte order (a file from a host of the
+// other order fails the magic check). Offsets are in bytes from the start.
+//   header     magic "MTWB", version, sequence count, total size
+//   directory  offset of each sequence's record
+//   record     from value, segment count n, ends[n] (float), end times[n]
+//              (int32, from the start of the sequence), easing ids[n] (one
+//              byte each, padded to a word)
+// Segment durations are stored as cumulative end times so the segment at a
+// given time can be found with a binary search.
+namespace microtween_format
+{
+	static const std::uint32_t magic = 0x4257544d;
+	static const std::uint32_t version = 1;
+	static const std::size_t header_words = 4;
+
+	inline std::size_t record_words(std::size_t n)
+	{
+		return 2 + 2 * n + (n + 3) / 4;
+	}
+}
+
+// Read-only view of a library in the binary format. The data must outlive the
+// view and any sequence taken from it.
+class microtween_binary
+{
+public:
+	typedef microtween::easing easing;
+
+	// One sequence, evaluated in place.
+	class sequence
+	{
+	public:
+		float from() const
+		{
+			return start;
+		}
+
+		// Number of segments.
+		std::size_t size() const
+		{
+			return count;
+		}
+
+		float end(std::size_t i) const
+		{
+			return ends[i];
+		}
+
+		int duration(std::size_t i) const
+		{
+			return times[i] - (i ? times[i - 1] : 0);
+		}
+
+		easing easing_of(std::size_t i) const
+		{
+			return static_cast<easing>(easings[i]);
+		}
+
+		// Length of the whole sequence.
+		int duration() const
+		{
+			return count ? times[count - 1] : 0;
+		}
+
+		// Value at time c, matching microtween::get(c) for the tween written.
+		float get(double c) const
+		{
+			if (count == 0)
+				return start;
+			if (c >= times[count - 1])
+				return ends[count - 1];
+
+			// First segment ending after c, which is never a zero-length one.
+			// Times before the start map to the first segment, like a tween's.
+			std::size_t i = 0;
+			if (c >= 0)
+				i = std::upper_bound(times, times + count, c, [](double v, std::int32_t t) { return v < t; }) - times;
+			const int t0 = i ? times[i - 1] : 0;
+			const int d = times[i] - t0;
+			const float a = i ? ends[i - 1] : start;
+			const float t = static_cast<float>(c - t0) * (d ? 1.f / d : 0.f);
+			return a + (ends[i] - a) * microtween::interpolate(t, static_cast<easing>(easings[i]));
+		}
+
+		// Builds a playable tween with the same segments.
+		microtween tween() const
+		{
+			microtween t;
+			t.reset(start);
+			for (std::size_t i = 0; i < count; ++i)
+				t.to(ends[i], duration(i), static_cast<easing>(easings[i]));
+			return t;
+		}
+
+	private:
+		friend class microtween_binary;
+
+		float start = 0;
+		std::size_t count = 0;
+		const float* ends = nullptr;
+		const std::int32_t* times = nullptr;
+		const std::uint8_t* easings = nullptr;
+	};
+
+	// Points the view at size bytes of data, which must be 4-byte aligned.
+	// Returns false, leaving the view empty, if the header or any record
+	// doesn't fit the data or a segment has an unknown easing id. Ends and
+	// times are not checked.
+	bool open(const void* data, std::size_t size)
+	{
+		words = nullptr;
+		count = 0;
+
+		const std::uint32_t* w = static_cast<const std::uint32_t*>(data);
+		if (!data || reinterpret_cast<std::uintptr_t>(data) % 4 || size < microtween_format::header_words * 4)
+			return false;
+		if (w[0] != microtween_format::magic || w[1] != microtween_format::version || w[3] > size)
+			return false;
+
+		const std::size_t n = w[2];
+		const std::size_t total = w[3] / 4;
+		if (total < microtween_format::header_words || n > total - microtween_format::header_words)
+			return false;
+
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			const std::uint32_t offset = w[microtween_format::header_words + i];
+			const std::size_t k = offset / 4;
+			if (offset % 4 || k + 2 > total || w[k + 1] > total || k + microtween_format::record_words(w[k + 1]) > total)
+				return false;
+
+			const std::uint8_t* e = reinterpret_cast<const std::uint8_t*>(w + k + 2 + 2 * w[k + 1]);
+			for (std::size_t j = 0; j < w[k + 1]; ++j)
+				if (e[j] > static_cast<std::uint8_t>(easing::back_in_out))
+					return false;
+		}
+
+		words = w;
+		count = n;
+		return true;
+	}
+
+	// Number of sequences.
+	std::size_t size() const
+	{
+		return count;
+	}
+
+	sequence operator[](std::size_t i) const
+	{
+		const std::uint32_t* r = words + words[microtween_format::header_words + i] / 4;
+		sequence s;
+		std::memcpy(&s.start, r, sizeof(float));
+		s.count = r[1];
+		s.ends = reinterpret_cast<const float*>(r + 2);
+		s.times = reinterpret_cast<const std::int32_t*>(r + 2 + s.count);
+		s.easings = reinterpret_cast<const std::uint8_t*>(r + 2 + 2 * s.count);
+		return s;
+	}
+
+private:
+	const std::uint32_t* words = nullptr;
+	std::size_t count = 0;
+};
+
+// Builds a library in the binary format from tweens.
+class microtween_binary_writer
+{
+public:
+	// Appends the from value and segments of t and returns the index of the
+	// sequence, or -1 if t has curve or spline segments, which the format
+	// can't hold. Callbacks, repeats and the cursor are not stored.
+	int add(const microtween& t)
+	{
+		for (const auto& i : t.sequence)
+			if (i.curve)
+				return -1;
+
+		const std::size_t n = t.sequence.size();
+		offsets.push_back(static_cast<std::uint32_t>(records.size()));
+		const std::size_t r = records.size();
+		records.resize(r + microtween_format::record_words(n), 0);
+
+		std::memcpy(&records[r], &t.from_value, sizeof(float));
+		records[r + 1] = static_cast<std::uint32_t>(n);
+		std::uint8_t* easings = reinterpret_cast<std::uint8_t*>(&records[r + 2 + 2 * n]);
+		std::int32_t time = 0;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			time += t.sequence[i].duration;
+			std::memcpy(&records[r + 2 + i], &t.sequence[i].end, sizeof(float));
+			std::memcpy(&records[r + 2 + n + i], &time, sizeof(time));
+			easings[i] = static_cast<std::uint8_t>(t.sequence[i].easing);
+		}
+		return static_cast<int>(offsets.size()) - 1;
+	}
+
+	// Number of sequences added.
+	std::size_t size() const
+	{
+		return offsets.size();
+	}
+
+	void clear()
+	{
+		offsets.clear();
+		records.clear();
+	}
+
+	// The library, ready to be written to a file or passed to
+	// microtween_binary::open().
+	std::vector<std::uint32_t> data() const
+	{
+		const std::size_t base = microtween_format::header_words + offsets.size();
+		std::vector<std::uint32_t> out;
+		out.reserve(base + records.size());
+		out.push_back(microtween_format::magic);
+		out.push_back(microtween_format::version);
+		out.push_back(static_cast<std::uint32_t>(offsets.size()));
+		out.push_back(static_cast<std::uint32_t>((base + records.size()) * 4));
+		for (std::uint32_t i : offsets)
+			out.push_back(static_cast<std::uint32_t>(base * 4 + i * 4));
+		out.insert(out.end(), records.begin(), records.end());
+		return out;
+	}
+
+private:
+	// Start of each record in records, in words.
+	std::vector<std::uint32_t> offsets;
+	std::vector<std::uint32_t> records;
+};
@@ -0,0 +1,290 @@
+#pragma once
+#include <climits>
+#include <cstddef>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "microtween_pool.h"
+
+// Streaming parser of text tween definitions into a microtween_pool, one
+// tween per line:
+//   from 0; to 300 300 cubic_in; wait 10   # comment
+// from sets the start value (0 if omitted) and may only open a line; to takes
+// an end value, a duration in ticks and an optional easing name; wait takes
+// a duration. Text is parsed in one pass as it is fed, through a fixed token
+// buffer, so nothing is allocated per token.
+class microtween_loader
+{
+public:
+	typedef microtween::easing easing;
+
+	explicit microtween_loader(microtween_pool& pool) : pool(pool) {}
+
+	// Parses the next n bytes. The text may be split anywhere between calls,
+	// even inside a token.
+	void feed(const char* data, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			const char c = data[i];
+			if (c == '\n')
+			{
+				end_line();
+				continue;
+			}
+			if (skipping)
+				continue;
+
+			if (c == ' ' || c == '\t' || c == '\r')
+			{
+				end_token();
+			}
+			else if (c == ';')
+			{
+				end_token();
+				end_statement();
+			}
+			else if (c == '#')
+			{
+				end_token();
+				end_statement();
+				skipping = true;
+			}
+			else if (length + 1 < sizeof(token))
+			{
+				token[length++] = c;
+			}
+			else
+			{
+				fail();
+			}
+		}
+	}
+
+	// Ends the text. Returns false if any line had an error.
+	bool finish()
+	{
+		end_line();
+		return first_error == 0;
+	}
+
+	bool load(const char* text, std::size_t n)
+	{
+		feed(text, n);
+		return finish();
+	}
+
+	// Ids of the tweens created, in the order of their lines.
+	const std::vector<int>& tweens() const
+	{
+		return created;
+	}
+
+	// Line of the first error, counting from 1, or 0 if there was none. The
+	// tween of a line with an error keeps the statements before it.
+	int error() const
+	{
+		return first_error;
+	}
+
+private:
+	enum command { none, from, to, wait };
+
+	microtween_pool& pool;
+	std::vector<int> created;
+
+	char token[32];
+	std::size_t length = 0;
+	int line = 1;
+	int first_error = 0;
+	// Set from an error or comment to the end of the line.
+	bool skipping = false;
+
+	// Statement being read and the tween of the current line, or -1.
+	command current = none;
+	int args = 0;
+	float value = 0;
+	int duration = 0;
+	easing shape = easing::linear;
+	int id = -1;
+
+	void fail()
+	{
+		if (!first_error)
+			first_error = line;
+		skipping = true;
+		current = none;
+		length = 0;
+	}
+
+	void end_line()
+	{
+		if (!skipping)
+		{
+			end_token();
+			end_statement();
+		}
+		skipping = false;
+		length = 0;
+		id = -1;
+		++line;
+	}
+
+	void end_token()
+	{
+		if (length == 0)
+			return;
+		token[length] = 0;
+		length = 0;
+
+		if (current == none)
+		{
+			if (std::strcmp(token, "from") == 0)
+				current = from;
+			else if (std::strcmp(token, "to") == 0)
+				current = to;
+			else if (std::strcmp(token, "wait") == 0)
+				current = wait;
+			else
+				return fail();
+			args = 0;
+			shape = easing::linear;
+			return;
+		}
+
+		double v;
+		if ((current == to && args == 1) || (current == wait && args == 0))
+		{
+			if (!number(token, v) || v < 0 || v > INT_MAX || v != static_cast<int>(v))
+				return fail();
+			duration = static_cast<int>(v);
+		}
+		else if (args == 0 && current != wait)
+		{
+			if (!number(token, v) || std::fabs(v) > FLT_MAX)
+				return fail();
+			value = static_cast<float>(v);
+		}
+		else if (current == to && args == 2)
+		{
+			if (!find(token, shape))
+				return fail();
+		}
+		else
+		{
+			return fail();
+		}
+		++args;
+	}
+
+	void end_statement()
+	{
+		const command c = current;
+		current = none;
+		if (c == none)
+			return;
+
+		if (args < (c == to ? 2 : 1) || (c == from && id >= 0))
+			return fail();
+
+		if (id < 0)
+		{
+			id = pool.create(c == from ? value : 0.f);
+			created.push_back(id);
+		}
+		if (c == to)
+			pool.append(id, value, duration, shape);
+		else if (c == wait)
+			pool.wait(id, duration);
+	}
+
+	// Parses a decimal number with optional sign, fraction and exponent. Much
+	// faster than strtod, which also honours the locale. Correctly rounded for
+	// up to 15 significant digits and exponents within 22, where the digits
+	// and the power of ten are exact doubles; longer numbers keep 18 digits
+	// and may be off by an ulp. Numbers beyond the range of a double fail.
+	static bool number(const char* s, double& v)
+	{
+		const bool negative = *s == '-';
+		if (*s == '-' || *s == '+')
+			++s;
+
+		std::uint64_t mantissa = 0;
+		int digits = 0;
+		int scale = 0;
+		for (; *s >= '0' && *s <= '9'; ++s, ++digits)
+		{
+			if (mantissa < 100000000000000000ull)
+				mantissa = mantissa * 10 + (*s - '0');
+			else
+				++scale;
+		}
+		if (*s == '.')
+		{
+			for (++s; *s >= '0' && *s <= '9'; ++s, ++digits)
+			{
+				if (mantissa < 100000000000000000ull)
+				{
+					mantissa = mantissa * 10 + (*s - '0');
+					--scale;
+				}
+			}
+		}
+		if (digits == 0)
+			return false;
+
+		if (*s == 'e' || *s == 'E')
+		{
+			++s;
+			const bool down = *s == '-';
+			if (*s == '-' || *s == '+')
+				++s;
+			if (*s < '0' || *s > '9')
+				return false;
+			int e = 0;
+			for (; *s >= '0' && *s <= '9'; ++s)
+				e = e < 1000 ? e * 10 + (*s - '0') : e;
+			scale += down ? -e : e;
+		}
+		if (*s)
+			return false;
+
+		if (mantissa == 0)
+			scale = 0;
+		v = static_cast<double>(mantissa);
+		if (scale < 0)
+			v /= std::pow(10., -scale);
+		else if (scale > 0)
+			v *= std::pow(10., scale);
+		if (negative)
+			v = -v;
+		return std::isfinite(v);
+	}
+
+	static bool find(const char* name, easing& e)
+	{
+		static const char* const names[] = {
+			"linear",
+			"sine_in", "sine_out", "sine_in_out",
+			"quadratic_in", "quadratic_out", "quadratic_in_out",
+			"cubic_in", "cubic_out", "cubic_in_out",
+			"quartic_in", "quartic_out", "quartic_in_out",
+			"quintic_in", "quintic_out", "quintic_in_out",
+			"exponential_in", "exponential_out", "exponential_in_out",
+			"circular_in", "circular_out", "circular_in_out",
+			"elastic_in", "elastic_out", "elastic_in_out",
+			"back_in", "back_out", "back_in_out"
+		};
+		for (std::size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+		{
+			if (std::strcmp(name, names[i]) == 0)
+			{
+				e = static_cast<easing>(i);
+				return true;
+			}
+		}
+		return false;
+	}
+};
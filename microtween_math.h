@@ -0,0 +1,85 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Polynomial approximations of the transcendental functions used by the
+// easings. They are written once against a handful of primitives (select,
+// floor, flip, pow2i, sqrt) so the same code serves plain floats and the SIMD packs
+// in microtween_simd.h, which overload those primitives for their own types.
+namespace microtween_math
+{
+	inline float select(bool m, float a, float b)
+	{
+		return m ? a : b;
+	}
+
+	// Only used on arguments well inside the int range, where truncating and
+	// correcting is cheaper than std::floor (a libm call before SSE4.1).
+	inline float floor(float x)
+	{
+		const float t = static_cast<float>(static_cast<std::int32_t>(x));
+		return t > x ? t - 1.f : t;
+	}
+
+	inline float sqrt(float x)
+	{
+		return std::sqrt(x);
+	}
+
+	// v with its sign flipped when the integral k is odd.
+	inline float flip(float v, float k)
+	{
+		return static_cast<std::int32_t>(k) & 1 ? -v : v;
+	}
+
+	// 2^n for an integral n in [-126, 127].
+	inline float pow2i(float n)
+	{
+		const std::int32_t bits = (static_cast<std::int32_t>(n) + 127) << 23;
+		float r;
+		std::memcpy(&r, &bits, sizeof(r));
+		return r;
+	}
+
+	// sin(x), absolute error below 2e-7 for |x| < 100. x is reduced to
+	// r = x - k * pi with |r| <= pi / 2 and sin(x) = (-1)^k * sin(r), where
+	// sin(r) is its Taylor series up to r^11.
+	template <class V>
+	V sin(V x)
+	{
+		const V k = floor(x * 0.318309886f + .5f);
+		const V r = x - k * 3.140625f - k * 9.67653589793e-4f;
+		const V r2 = r * r;
+		V p = -2.50521084e-8f;
+		p = p * r2 + 2.75573192e-6f;
+		p = p * r2 - 1.98412698e-4f;
+		p = p * r2 + 8.33333333e-3f;
+		p = p * r2 - 1.66666667e-1f;
+		return flip(r + r * r2 * p, k);
+	}
+
+	template <class V>
+	V cos(V x)
+	{
+		return sin(x + 1.570796327f);
+	}
+
+	// 2^x, relative error below 3e-7. x is clamped to [-126, 127] and split
+	// into n + f with |f| <= 0.5; 2^f uses the Cephes exp2f polynomial.
+	template <class V>
+	V exp2(V x)
+	{
+		x = select(x < -126.f, V(-126.f), x);
+		x = select(x > 127.f, V(127.f), x);
+		const V n = floor(x + .5f);
+		const V f = x - n;
+		V p = 1.535336188319500e-4f;
+		p = p * f + 1.339887440266574e-3f;
+		p = p * f + 9.618437357674640e-3f;
+		p = p * f + 5.550332471162809e-2f;
+		p = p * f + 2.402264791363012e-1f;
+		p = p * f + 6.931472028550421e-1f;
+		return (1.f + f * p) * pow2i(n);
+	}
+}
@@ -0,0 +1,187 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "microtween.h"
+#include "microtween_simd.h"
+
+// Bank of float sequences in quantized form, for very large offline
+// populations. Values are 16-bit steps between the bank's lo and hi,
+// durations are 16-bit and easing ids take one byte, so a segment costs 5
+// bytes in three flat arrays (a tween's costs 20) and sequences are read
+// straight from them. Values are off by at most half a step, (hi - lo) /
+// 131070, times the reach of the easing.
+class microtween_packed
+{
+public:
+	typedef microtween::easing easing;
+
+	microtween_packed(float lo, float hi) : lo(lo), hi(hi), step((hi - lo) / 65535), inv_step(hi > lo ? 65535 / (hi - lo) : 0) {}
+
+	// Appends the from value and segments of t and returns the index of the
+	// sequence, or -1 if t doesn't fit: values outside [lo, hi], durations
+	// over 65535, or curve and spline segments. Callbacks, repeats and the
+	// cursor are not stored.
+	int add(const microtween& t)
+	{
+		if (!fits(t.from_value))
+			return -1;
+		for (const auto& i : t.sequence)
+			if (i.curve || i.duration > 65535 || !fits(i.end))
+				return -1;
+
+		if (first.empty())
+			first.push_back(0);
+		from.push_back(quantize(t.from_value));
+		for (const auto& i : t.sequence)
+		{
+			ends.push_back(quantize(i.end));
+			durations.push_back(static_cast<std::uint16_t>(i.duration));
+			easings.push_back(static_cast<std::uint8_t>(i.easing));
+		}
+		first.push_back(static_cast<std::uint32_t>(ends.size()));
+		return static_cast<int>(from.size()) - 1;
+	}
+
+	void reserve(std::size_t sequences, std::size_t segments)
+	{
+		from.reserve(sequences);
+		first.reserve(sequences + 1);
+		ends.reserve(segments);
+		durations.reserve(segments);
+		easings.reserve(segments);
+	}
+
+	void clear()
+	{
+		from.clear();
+		first.clear();
+		ends.clear();
+		durations.clear();
+		easings.clear();
+	}
+
+	// Number of sequences.
+	std::size_t size() const
+	{
+		return from.size();
+	}
+
+	// Bytes used by the sequences.
+	std::size_t memory() const
+	{
+		return from.size() * sizeof(std::uint16_t) + first.size() * sizeof(std::uint32_t) +
+			ends.size() * (2 * sizeof(std::uint16_t) + sizeof(std::uint8_t));
+	}
+
+	int duration(std::size_t i) const
+	{
+		int d = 0;
+		for (std::uint32_t k = first[i]; k < first[i + 1]; ++k)
+			d += durations[k];
+		return d;
+	}
+
+	// Value of sequence i at time c, matching microtween::get(c) for a tween
+	// holding the quantized values. Walks the segments from the start.
+	float get(std::size_t i, double c) const
+	{
+		float a = value(from[i]);
+		int t0 = 0;
+		for (std::uint32_t k = first[i]; k < first[i + 1]; ++k)
+		{
+			// Zero-length segments are skipped, but for times before the
+			// start, which map to the first segment.
+			const int d = durations[k];
+			if (c < t0 + d || (k == first[i] && c < 0))
+			{
+				const float t = static_cast<float>(c - t0) * (d ? 1.f / d : 0.f);
+				const float b = value(ends[k]);
+				return a + (b - a) * microtween::interpolate(t, static_cast<easing>(easings[k]));
+			}
+			a = value(ends[k]);
+			t0 += d;
+		}
+		return a;
+	}
+
+	// Writes sequence i at c0, c0 + stride, c0 + 2 * stride, ... to out, with
+	// c0 >= 0 and stride > 0. Segments are walked once and each run of
+	// samples is eased as a batch.
+	void get_range(std::size_t i, int c0, int count, int stride, float* out) const
+	{
+		float a = value(from[i]);
+		int t0 = 0;
+		int c = c0;
+		int k = 0;
+		for (std::uint32_t s = first[i]; s < first[i + 1] && k < count; ++s)
+		{
+			const int d = durations[s];
+			const float b = value(ends[s]);
+			if (c < t0 + d)
+			{
+				const int n = std::min(count - k, (t0 + d - c + stride - 1) / stride);
+				const float inv = 1.f / d;
+				for (int j = 0; j < n; ++j)
+					out[k + j] = static_cast<float>(c + j * stride - t0) * inv;
+				microtween_simd::ease(static_cast<easing>(easings[s]), out + k, out + k, n);
+				for (int j = 0; j < n; ++j)
+					out[k + j] = a + (b - a) * out[k + j];
+				k += n;
+				c += n * stride;
+			}
+			a = b;
+			t0 += d;
+		}
+		for (; k < count; ++k)
+			out[k] = a;
+	}
+
+	// Builds a playable tween with the quantized values.
+	microtween tween(std::size_t i) const
+	{
+		microtween t;
+		t.reset(value(from[i]));
+		for (std::uint32_t k = first[i]; k < first[i + 1]; ++k)
+			t.to(value(ends[k]), durations[k], static_cast<easing>(easings[k]));
+		return t;
+	}
+
+	// Largest difference between a value and its quantized form.
+	float error() const
+	{
+		return step * .5f;
+	}
+
+private:
+	float lo;
+	float hi;
+	float step;
+	float inv_step;
+
+	// Per sequence: quantized from value and index of the first segment,
+	// with one more entry ending the last sequence.
+	std::vector<std::uint16_t> from;
+	std::vector<std::uint32_t> first;
+	// Per segment.
+	std::vector<std::uint16_t> ends;
+	std::vector<std::uint16_t> durations;
+	std::vector<std::uint8_t> easings;
+
+	bool fits(float v) const
+	{
+		return v >= lo && v <= hi;
+	}
+
+	std::uint16_t quantize(float v) const
+	{
+		return static_cast<std::uint16_t>(std::min(65535.f, std::floor((v - lo) * inv_step + .5f)));
+	}
+
+	float value(std::uint16_t q) const
+	{
+		return q == 65535 ? hi : lo + q * step;
+	}
+};
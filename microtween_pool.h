@@ -0,0 +1,562 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include <cmath>
+#include <algorithm>
+#include "microtween.h"
+#include "microtween_simd.h"
+#include "microtween_wheel.h"
+#include "microtween_workers.h"
+
+// Many tweens stepped together. The state of each tween's active segment is
+// kept in parallel arrays, so step_all() is one linear sweep over the
+// population, taken in groups of tweens sharing an easing so each group is
+// eased at full vector width. The end of every active segment is scheduled on a timing wheel,
+// so moving tweens on to their next segment, calling callbacks and reporting
+// finished tweens only touches the tweens due.
+class microtween_pool
+{
+public:
+	typedef microtween::easing easing;
+
+	// Copies the sequence, callbacks and cursor of t into the pool and returns
+	// the id of the new tween. The pool steps whole ticks, so a fractional
+	// cursor is rounded down. Repeats are not copied; the pool plays the pass
+	// t is in to its end.
+	int add(const microtween& t)
+	{
+		if (segments.size() >= compact_at)
+			compact();
+
+		const int id = static_cast<int>(value.size());
+		const int first = static_cast<int>(segments.size());
+
+		const int first_curve = static_cast<int>(curves.size());
+		const int first_spline = static_cast<int>(splines.size());
+		curves.insert(curves.end(), t.curves.begin(), t.curves.end());
+		splines.insert(splines.end(), t.splines.begin(), t.splines.end());
+		for (const auto& i : t.sequence)
+		{
+			const int c = i.curve ? (i.keyed ? first_spline : first_curve) + i.curve - 1 : -1;
+			segments.push_back({ i.end, i.duration, i.easing, i.keyed, -1, c });
+		}
+
+		for (const auto& i : t.hooks)
+		{
+			segments[first + i.segment].cb = static_cast<int>(callbacks.size());
+			callbacks.push_back(i.cb);
+		}
+
+		start.push_back(clock - (static_cast<int>(std::floor(t.position)) - t.active_start));
+		active.push_back(first + static_cast<int>(t.active));
+		last.push_back(static_cast<int>(segments.size()));
+		length.push_back(0);
+		from.push_back(0);
+		delta.push_back(0);
+		inv_duration.push_back(0);
+		easings.push_back(static_cast<std::uint8_t>(easing::linear));
+		value.push_back(0);
+		curved_at.push_back(-1);
+		order_at.push_back(0);
+		join(id);
+
+		if (t.active < t.sequence.size())
+			load(id, t.active_from);
+		else
+			load(id, t.sequence.empty() ? t.from_value : t.sequence.back().end);
+		schedule(id);
+		value[id] = evaluate(id);
+		return id;
+	}
+
+	// Adds an empty tween holding from and returns its id.
+	int create(float from)
+	{
+		const int id = static_cast<int>(value.size());
+		create(id, from);
+		return id;
+	}
+
+	// Appends a segment to tween id, like microtween::to(). Segments already
+	// reached keep their timing, so appending to a finished tween continues
+	// from where its cursor is.
+	void append(int id, float end, int d, easing e = easing::linear)
+	{
+		if (last[id] != static_cast<int>(segments.size()))
+			relocate(id);
+
+		segments.push_back({ end, d, e, false, -1, -1 });
+		++last[id];
+		if (active[id] == last[id] - 1)
+		{
+			load(id, from[order_at[id]]);
+			advance(id, [this](int cb) { call(cb); });
+			schedule(id);
+		}
+		value[id] = evaluate(id);
+		if (deferred && !dispatching)
+			compact();
+	}
+
+	void wait(int id, int d)
+	{
+		append(id, active[id] < last[id] ? segments[last[id] - 1].end : from[order_at[id]], d);
+	}
+
+	// Stops tween id where it is. It keeps its current value and counts as
+	// finished; its remaining segments and callbacks are dropped.
+	void kill(int id)
+	{
+		start[order_at[id]] = clock;
+		active[id] = last[id];
+		load(id, value[id]);
+		wheel.cancel(id);
+	}
+
+	// Drops segments no tween will reach again. Called automatically when the
+	// segment array has doubled since the last compaction. Compaction renumbers
+	// the callbacks, so while one is running it waits until they are done.
+	void compact()
+	{
+		if (dispatching)
+		{
+			deferred = true;
+			return;
+		}
+		deferred = false;
+
+		std::vector<segment> kept;
+		std::vector<microtween::cb_t> kept_callbacks;
+		std::vector<microtween::curve> kept_curves;
+		std::vector<const microtween_spline*> kept_splines;
+		kept.reserve(segments.size() / 2);
+
+		const int n = static_cast<int>(value.size());
+		for (int i = 0; i < n; ++i)
+		{
+			const int first = static_cast<int>(kept.size());
+			for (int k = active[i]; k < last[i]; ++k)
+			{
+				segment p = segments[k];
+				if (p.cb >= 0)
+				{
+					kept_callbacks.push_back(callbacks[p.cb]);
+					p.cb = static_cast<int>(kept_callbacks.size()) - 1;
+				}
+				if (p.curve >= 0 && p.keyed)
+				{
+					kept_splines.push_back(splines[p.curve]);
+					p.curve = static_cast<int>(kept_splines.size()) - 1;
+				}
+				else if (p.curve >= 0)
+				{
+					kept_curves.push_back(curves[p.curve]);
+					p.curve = static_cast<int>(kept_curves.size()) - 1;
+				}
+				kept.push_back(p);
+			}
+			active[i] = first;
+			last[i] = static_cast<int>(kept.size());
+		}
+
+		segments.swap(kept);
+		callbacks.swap(kept_callbacks);
+		curves.swap(kept_curves);
+		splines.swap(kept_splines);
+		compact_at = 2 * segments.size() > min_compact ? 2 * segments.size() : min_compact;
+	}
+
+	void reserve(std::size_t n)
+	{
+		start.reserve(n);
+		active.reserve(n);
+		last.reserve(n);
+		length.reserve(n);
+		from.reserve(n);
+		delta.reserve(n);
+		inv_duration.reserve(n);
+		easings.reserve(n);
+		value.reserve(n);
+		curved_at.reserve(n);
+		order.reserve(n);
+		order_at.reserve(n);
+		progress.reserve(n);
+	}
+
+	void clear()
+	{
+		start.clear();
+		active.clear();
+		last.clear();
+		length.clear();
+		from.clear();
+		delta.clear();
+		inv_duration.clear();
+		easings.clear();
+		value.clear();
+		curved_at.clear();
+		curved.clear();
+		keys.clear();
+		order.clear();
+		order_at.clear();
+		progress.clear();
+		std::fill(groups, groups + shapes + 1, 0);
+		segments.clear();
+		callbacks.clear();
+		curves.clear();
+		splines.clear();
+		compact_at = min_compact;
+		deferred = false;
+		wheel.clear();
+		clock = 0;
+		due.clear();
+		done.clear();
+	}
+
+	std::size_t size() const
+	{
+		return value.size();
+	}
+
+	// Advances every tween by s and refreshes values(). Then the callbacks of
+	// all segments finished during this step are called, in the order the
+	// segments ended.
+	void step_all(int s = 1)
+	{
+		move(s);
+		evaluate_range(0, static_cast<int>(value.size()));
+		evaluate_curved();
+		call_due();
+	}
+
+	// Same as step_all(s), with the values refreshed by workers in chunks.
+	// Callbacks are still called on this thread.
+	void step_all(int s, microtween_workers& workers)
+	{
+		move(s);
+		const int n = static_cast<int>(value.size());
+		workers.run((n + chunk_size - 1) / chunk_size, [this, n](int k)
+		{
+			evaluate_range(k * chunk_size, std::min(n, (k + 1) * chunk_size));
+		});
+		evaluate_curved();
+		call_due();
+	}
+
+	// Tweens that finished during the last step_all(), in the order they
+	// finished.
+	const std::vector<int>& completed() const
+	{
+		return done;
+	}
+
+	const float* values() const
+	{
+		return value.data();
+	}
+
+	float get(int id) const
+	{
+		return value[id];
+	}
+
+	bool finished(int id) const
+	{
+		return active[id] >= last[id];
+	}
+
+private:
+	friend class microtween_command_queue;
+
+	struct segment
+	{
+		float end;
+		int duration;
+		easing shape;
+		bool keyed;
+		int cb;
+		// Index into curves, or splines if keyed; -1 for none.
+		int curve;
+	};
+
+	// Per tween: active and one past the last segment index, and the active
+	// segment's length and easing. A finished tween holds its end value with
+	// delta 0 and an unreachable length.
+	std::vector<int> active;
+	std::vector<int> last;
+	std::vector<int> length;
+	std::vector<std::uint8_t> easings;
+	std::vector<float> value;
+	// Per position in order (see below), so step_all() reads them in
+	// sequence: time the active segment started, its start value, change of
+	// value and reciprocal length.
+	std::vector<std::int64_t> start;
+	std::vector<float> from;
+	std::vector<float> delta;
+	std::vector<float> inv_duration;
+
+	std::vector<segment> segments;
+	std::vector<microtween::cb_t> callbacks;
+	std::vector<microtween::curve> curves;
+	std::vector<const microtween_spline*> splines;
+
+	// Tweens whose active segment has a curve or spline, which the batched
+	// easing can't evaluate, and each tween's position in that list or -1.
+	// keys holds the spline piece each of them sampled last, as a hint for
+	// the next search.
+	std::vector<int> curved;
+	std::vector<int> curved_at;
+	std::vector<std::size_t> keys;
+
+	// Tweens grouped by easing, each tween's position in that order, and the
+	// first position of each easing's group (shapes + 1 entries, the last
+	// one being the size). step_all() sweeps this order, with progress[p]
+	// holding the eased time of the tween at position p. Moving a tween to
+	// another group moves its per-position state along.
+	static const int shapes = static_cast<int>(easing::back_in_out) + 1;
+	std::vector<int> order;
+	std::vector<int> order_at;
+	int groups[shapes + 1] = {};
+	std::vector<float> progress;
+
+	// Size of segments that triggers the next compact().
+	static const std::size_t min_compact = 1024;
+	std::size_t compact_at = min_compact;
+	// Callbacks running, and whether a compaction waits for them to return.
+	int dispatching = 0;
+	bool deferred = false;
+
+	// Tweens per chunk of a parallel step.
+	static const int chunk_size = 4096;
+
+	// Time of the pool, and the end of each tween's active segment keyed on it.
+	std::int64_t clock = 0;
+	microtween_wheel wheel;
+	// Callbacks due and tweens finished during the current step.
+	std::vector<int> due;
+	std::vector<int> done;
+
+	// Advances the clock and moves every tween whose active segment ended on
+	// to its next one, queueing the callbacks of the segments left.
+	void move(int s)
+	{
+		clock += s;
+		due.clear();
+		done.clear();
+		wheel.advance(clock, [this](int i)
+		{
+			const bool running = active[i] < last[i];
+			advance(i, [this](int cb) { due.push_back(cb); });
+			if (running && active[i] >= last[i])
+				done.push_back(i);
+			schedule(i);
+		});
+	}
+
+	void evaluate_curved()
+	{
+		for (int i : curved)
+			value[i] = evaluate(i);
+	}
+
+	void call_due()
+	{
+		for (std::size_t k = 0; k < due.size(); ++k)
+			call(due[k]);
+		if (deferred && !dispatching)
+			compact();
+	}
+
+	// Runs a copy of callback cb, so the callback may add tweens and grow the
+	// callback array under itself.
+	void call(int cb)
+	{
+		const microtween::cb_t f = callbacks[cb];
+		++dispatching;
+		f();
+		--dispatching;
+	}
+
+	// Refreshes the values of the tweens at positions begin .. end - 1 of
+	// order, easing each group's run with one call.
+	void evaluate_range(int begin, int end)
+	{
+		for (int p = begin; p < end; ++p)
+			progress[p] = static_cast<float>(clock - start[p]) * inv_duration[p];
+
+		for (int e = 0; e < shapes; ++e)
+		{
+			const int lo = std::max(begin, groups[e]);
+			const int hi = std::min(end, groups[e + 1]);
+			if (lo < hi)
+				microtween_simd::ease(static_cast<easing>(e), progress.data() + lo, progress.data() + lo, hi - lo);
+		}
+
+		for (int p = begin; p < end; ++p)
+			value[order[p]] = from[p] + delta[p] * progress[p];
+	}
+
+	// Puts a new tween into order, in the group of linear.
+	void join(int i)
+	{
+		order_at[i] = static_cast<int>(order.size());
+		order.push_back(i);
+		progress.push_back(0);
+		++groups[shapes];
+		easings[i] = static_cast<std::uint8_t>(shapes - 1);
+		regroup(i, easing::linear);
+	}
+
+	// Gives tween i easing e, moving it across the groups in between one swap
+	// at a time.
+	void regroup(int i, easing e)
+	{
+		int g = easings[i];
+		for (; g < static_cast<int>(e); ++g)
+			swap_order(order_at[i], --groups[g + 1]);
+		for (; g > static_cast<int>(e); --g)
+			swap_order(order_at[i], groups[g]++);
+		easings[i] = static_cast<std::uint8_t>(e);
+	}
+
+	void swap_order(int p, int q)
+	{
+		std::swap(order[p], order[q]);
+		std::swap(start[p], start[q]);
+		std::swap(from[p], from[q]);
+		std::swap(delta[p], delta[q]);
+		std::swap(inv_duration[p], inv_duration[q]);
+		order_at[order[p]] = p;
+		order_at[order[q]] = q;
+	}
+
+	// Makes tween id an empty tween holding from, adding slots up to id.
+	void create(int id, float from)
+	{
+		const std::size_t size = value.size();
+		const std::size_t n = std::max(size, static_cast<std::size_t>(id) + 1);
+		const int end = static_cast<int>(segments.size());
+		start.resize(n, clock);
+		active.resize(n, end);
+		last.resize(n, end);
+		length.resize(n, INT_MAX);
+		this->from.resize(n, 0);
+		delta.resize(n, 0);
+		inv_duration.resize(n, 0);
+		easings.resize(n, static_cast<std::uint8_t>(easing::linear));
+		value.resize(n, 0);
+		curved_at.resize(n, -1);
+		order_at.resize(n, 0);
+		for (std::size_t k = size; k < n; ++k)
+			join(static_cast<int>(k));
+
+		start[order_at[id]] = clock;
+		active[id] = last[id] = end;
+		load(id, from);
+		wheel.cancel(id);
+		value[id] = from;
+	}
+
+	// Moves the remaining segments of tween id to the end of the segment
+	// array so it can grow in place.
+	void relocate(int id)
+	{
+		if (segments.size() >= compact_at)
+			compact();
+		if (last[id] == static_cast<int>(segments.size()))
+			return;
+
+		const int first = static_cast<int>(segments.size());
+		for (int k = active[id]; k < last[id]; ++k)
+			segments.push_back(segments[k]);
+		active[id] = first;
+		last[id] = static_cast<int>(segments.size());
+	}
+
+	float evaluate(int i)
+	{
+		const int k = order_at[i];
+		const float t = static_cast<float>(clock - start[k]) * inv_duration[k];
+		if (curved_at[i] >= 0)
+		{
+			const segment& p = segments[active[i]];
+			if (p.keyed)
+			{
+				const microtween_spline& s = *splines[p.curve];
+				const float time = static_cast<float>(clock - start[k]);
+				std::size_t& key = keys[curved_at[i]];
+				key = s.find(time, key);
+				return s.at(key)(time);
+			}
+			return from[k] + delta[k] * curves[p.curve](t);
+		}
+		return from[k] + delta[k] * microtween_simd::ease(t, static_cast<easing>(easings[i]));
+	}
+
+	void load(int i, float start)
+	{
+		// Regrouping moves the tween's position, so it comes first.
+		const bool running = active[i] < last[i];
+		regroup(i, running ? segments[active[i]].shape : easing::linear);
+		const int k = order_at[i];
+		from[k] = start;
+		if (running)
+		{
+			const segment& p = segments[active[i]];
+			length[i] = p.duration;
+			delta[k] = p.end - start;
+			inv_duration[k] = p.duration ? 1.f / p.duration : 0.f;
+		}
+		else
+		{
+			length[i] = INT_MAX;
+			delta[k] = 0;
+			inv_duration[k] = 0;
+		}
+
+		const bool c = active[i] < last[i] && segments[active[i]].curve >= 0;
+		if (c && curved_at[i] < 0)
+		{
+			curved_at[i] = static_cast<int>(curved.size());
+			curved.push_back(i);
+			keys.push_back(0);
+		}
+		else if (c)
+		{
+			keys[curved_at[i]] = 0;
+		}
+		else if (curved_at[i] >= 0)
+		{
+			curved_at[curved.back()] = curved_at[i];
+			curved[curved_at[i]] = curved.back();
+			keys[curved_at[i]] = keys.back();
+			curved.pop_back();
+			keys.pop_back();
+			curved_at[i] = -1;
+		}
+	}
+
+	// Puts the end of tween i's active segment on the wheel.
+	void schedule(int i)
+	{
+		if (active[i] < last[i])
+			wheel.schedule(i, start[order_at[i]] + length[i]);
+		else
+			wheel.cancel(i);
+	}
+
+	template <class F>
+	void advance(int i, F&& fire)
+	{
+		while (active[i] < last[i] && clock - start[order_at[i]] >= length[i])
+		{
+			const segment& p = segments[active[i]];
+			start[order_at[i]] += length[i];
+			++active[i];
+			load(i, p.end);
+			if (p.cb >= 0)
+				fire(p.cb);
+		}
+	}
+};
@@ -0,0 +1,194 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include "microtween_pool.h"
+
+// Bounded lock-free queue for any number of producers and consumers
+// (D. Vyukov's sequence-numbered ring). Capacity is rounded up to a power of
+// two; push() fails instead of blocking when the ring is full.
+template <class T>
+class microtween_ring
+{
+public:
+	explicit microtween_ring(std::size_t capacity)
+	{
+		std::size_t n = 2;
+		while (n < capacity)
+			n *= 2;
+		mask = n - 1;
+		cells.reset(new cell[n]);
+		for (std::size_t i = 0; i < n; ++i)
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	bool push(const T& v)
+	{
+		std::size_t pos = tail.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			cell& c = cells[pos & mask];
+			const std::size_t seq = c.sequence.load(std::memory_order_acquire);
+			const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+			if (diff == 0)
+			{
+				if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					c.value = v;
+					c.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = tail.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	bool pop(T& v)
+	{
+		std::size_t pos = head.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			cell& c = cells[pos & mask];
+			const std::size_t seq = c.sequence.load(std::memory_order_acquire);
+			const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+			if (diff == 0)
+			{
+				if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					v = c.value;
+					c.sequence.store(pos + mask + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = head.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+private:
+	struct cell
+	{
+		std::atomic<std::size_t> sequence;
+		T value;
+	};
+
+	std::unique_ptr<cell[]> cells;
+	std::size_t mask;
+	// Producers and consumers advance different ends; keep them on separate
+	// cache lines.
+	char pad0[64];
+	std::atomic<std::size_t> tail{ 0 };
+	char pad1[64];
+	std::atomic<std::size_t> head{ 0 };
+	char pad2[64];
+};
+
+// Commands for a microtween_pool issued from any thread. Producers never lock
+// or touch the pool: create() hands out an id right away and each call only
+// pushes onto a lock-free ring. The thread stepping the pool applies them
+// with drain() before step_all():
+//
+//	queue.drain(pool);
+//	pool.step_all(s);
+//
+// Commands from one producer are applied in the order it issued them. Every
+// call returns false (create() returns -1) if the ring is full. Ids of killed
+// tweens are reused by later create() calls, so an id must not be used after
+// it has been killed.
+class microtween_command_queue
+{
+public:
+	typedef microtween::easing easing;
+
+	explicit microtween_command_queue(std::size_t capacity = 1 << 16) : commands(capacity), free_ids(capacity) {}
+
+	int create(float from)
+	{
+		int id;
+		if (!free_ids.pop(id))
+			id = next_id.fetch_add(1, std::memory_order_relaxed);
+
+		if (!commands.push({ kind::create, id, from, 0, easing::linear }))
+		{
+			free_ids.push(id);
+			return -1;
+		}
+		return id;
+	}
+
+	bool append(int id, float end, int d, easing e = easing::linear)
+	{
+		return commands.push({ kind::append, id, end, d, e });
+	}
+
+	bool wait(int id, int d)
+	{
+		return commands.push({ kind::wait, id, 0, d, easing::linear });
+	}
+
+	bool kill(int id)
+	{
+		return commands.push({ kind::kill, id, 0, 0, easing::linear });
+	}
+
+	// Applies every queued command to pool. Call from the thread that steps
+	// the pool, which should only ever be fed by this queue.
+	void drain(microtween_pool& pool)
+	{
+		command c;
+		while (commands.pop(c))
+		{
+			switch (c.type)
+			{
+			case kind::create:
+				pool.create(c.id, c.value);
+				break;
+			case kind::append:
+				pool.append(c.id, c.value, c.duration, c.shape);
+				break;
+			case kind::wait:
+				pool.wait(c.id, c.duration);
+				break;
+			case kind::kill:
+				pool.kill(c.id);
+				free_ids.push(c.id);
+				break;
+			}
+		}
+	}
+
+private:
+	enum class kind
+	{
+		create,
+		append,
+		wait,
+		kill
+	};
+
+	struct command
+	{
+		kind type;
+		int id;
+		float value;
+		int duration;
+		easing shape;
+	};
+
+	microtween_ring<command> commands;
+	microtween_ring<int> free_ids;
+	std::atomic<int> next_id{ 0 };
+};
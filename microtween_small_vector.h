@@ -0,0 +1,192 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Vector keeping its first N elements inside the object and moving to memory
+// from Alloc only when it grows past them. Provides the subset of std::vector
+// the tweens need.
+template <class T, std::size_t N, class Alloc = std::allocator<T>>
+class microtween_small_vector : private Alloc
+{
+	typedef std::allocator_traits<Alloc> traits;
+
+public:
+	typedef T value_type;
+	typedef T* iterator;
+	typedef const T* const_iterator;
+	typedef Alloc allocator_type;
+
+	explicit microtween_small_vector(const Alloc& a = Alloc()) : Alloc(a) {}
+
+	microtween_small_vector(const microtween_small_vector& other) :
+		Alloc(traits::select_on_container_copy_construction(other.allocator()))
+	{
+		reserve(other.count);
+		for (const T& i : other)
+			new (first + count++) T(i);
+	}
+
+	microtween_small_vector(microtween_small_vector&& other) : Alloc(other.allocator())
+	{
+		take(other);
+	}
+
+	microtween_small_vector& operator=(const microtween_small_vector& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			reserve(other.count);
+			for (const T& i : other)
+				new (first + count++) T(i);
+		}
+		return *this;
+	}
+
+	microtween_small_vector& operator=(microtween_small_vector&& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			if (!other.is_inline() && allocator() == other.allocator())
+			{
+				release();
+				first = other.first;
+				capacity_ = other.capacity_;
+				count = other.count;
+				other.reset_inline();
+			}
+			else
+			{
+				reserve(other.count);
+				for (T& i : other)
+					new (first + count++) T(std::move(i));
+				other.clear();
+			}
+		}
+		return *this;
+	}
+
+	~microtween_small_vector()
+	{
+		clear();
+		release();
+	}
+
+	template <class... Args>
+	T& emplace_back(Args&&... args)
+	{
+		if (count == capacity_)
+		{
+			// The new element is built before the old ones move, in case args
+			// refer to one of them.
+			const std::size_t n = capacity_ ? capacity_ * 2 : 1;
+			T* p = traits::allocate(allocator(), n);
+			new (p + count) T(std::forward<Args>(args)...);
+			relocate(p, n);
+		}
+		else
+		{
+			new (first + count) T(std::forward<Args>(args)...);
+		}
+		return first[count++];
+	}
+
+	void push_back(const T& v)
+	{
+		emplace_back(v);
+	}
+
+	void reserve(std::size_t n)
+	{
+		if (n > capacity_)
+			relocate(traits::allocate(allocator(), n), n);
+	}
+
+	void clear()
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			first[i].~T();
+		count = 0;
+	}
+
+	bool empty() const { return count == 0; }
+	std::size_t size() const { return count; }
+	std::size_t capacity() const { return capacity_; }
+
+	T* data() { return first; }
+	const T* data() const { return first; }
+	T* begin() { return first; }
+	const T* begin() const { return first; }
+	T* end() { return first + count; }
+	const T* end() const { return first + count; }
+	T& back() { return first[count - 1]; }
+	const T& back() const { return first[count - 1]; }
+	T& operator[](std::size_t i) { return first[i]; }
+	const T& operator[](std::size_t i) const { return first[i]; }
+
+private:
+	typename std::aligned_storage<sizeof(T), alignof(T)>::type buffer[N ? N : 1];
+	T* first = reinterpret_cast<T*>(buffer);
+	std::size_t count = 0;
+	std::size_t capacity_ = N;
+
+	Alloc& allocator() { return *this; }
+	const Alloc& allocator() const { return *this; }
+
+	bool is_inline() const
+	{
+		return first == reinterpret_cast<const T*>(buffer);
+	}
+
+	void reset_inline()
+	{
+		first = reinterpret_cast<T*>(buffer);
+		capacity_ = N;
+		count = 0;
+	}
+
+	void release()
+	{
+		if (!is_inline())
+			traits::deallocate(allocator(), first, capacity_);
+		reset_inline();
+	}
+
+	// Moves the elements to p, which holds n elements, and frees the old heap
+	// block.
+	void relocate(T* p, std::size_t n)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			new (p + i) T(std::move(first[i]));
+			first[i].~T();
+		}
+		const std::size_t c = count;
+		release();
+		first = p;
+		capacity_ = n;
+		count = c;
+	}
+
+	// Only for a freshly constructed, empty vector sharing other's allocator.
+	void take(microtween_small_vector& other)
+	{
+		if (!other.is_inline())
+		{
+			first = other.first;
+			capacity_ = other.capacity_;
+			count = other.count;
+			other.reset_inline();
+			return;
+		}
+
+		reserve(other.count);
+		for (T& i : other)
+			new (first + count++) T(std::move(i));
+		other.clear();
+	}
+};
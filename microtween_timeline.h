@@ -0,0 +1,155 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include "microtween.h"
+
+// Tweens played in parallel on one clock, each starting at its own offset.
+// step() only visits children that are running or start during the step;
+// children waiting for their offset and finished children are skipped.
+template <class Tween = microtween>
+class basic_microtween_timeline
+{
+public:
+	typedef typename Tween::value_type value_type;
+
+	// Adds t, starting offset ticks after the timeline starts, and returns its
+	// index. t plays from its own cursor, normally 0.
+	int add(const Tween& t, int offset = 0)
+	{
+		const int id = static_cast<int>(children.size());
+		children.push_back(t);
+		offsets.push_back(offset);
+		local.push_back(0);
+		const int d = t.duration();
+		end = std::max(end, static_cast<int>(std::min<long long>(INT_MAX, static_cast<long long>(offset) + d)));
+
+		const auto it = std::upper_bound(order.begin(), order.end(), offset,
+			[this](int o, int i) { return o < offsets[i]; });
+		order.insert(it, id);
+		if (offset <= cursor)
+		{
+			++next;
+			start(id);
+		}
+		return id;
+	}
+
+	void clear()
+	{
+		children.clear();
+		offsets.clear();
+		local.clear();
+		order.clear();
+		running.clear();
+		next = 0;
+		cursor = 0;
+		end = 0;
+	}
+
+	// Advances the shared clock by s ticks, which may be fractional. Children's
+	// callbacks fire in the order the children started. Stepping backwards
+	// re-seats every child.
+	void step(double s = 1)
+	{
+		if (s < 0)
+		{
+			seek(cursor + s);
+			return;
+		}
+
+		cursor += s;
+
+		std::size_t kept = 0;
+		for (std::size_t k = 0; k < running.size(); ++k)
+		{
+			const int i = running[k];
+			children[i].step(s);
+			local[i] += s;
+			if (!children[i].finished())
+				running[kept++] = i;
+		}
+		running.resize(kept);
+
+		while (next < order.size() && offsets[order[next]] <= cursor)
+			start(order[next++]);
+	}
+
+	value_type get(int i) const
+	{
+		return children[i].get();
+	}
+
+	const Tween& child(int i) const
+	{
+		return children[i];
+	}
+
+	std::size_t size() const
+	{
+		return children.size();
+	}
+
+	// Number of children currently playing.
+	std::size_t playing() const
+	{
+		return running.size();
+	}
+
+	int duration() const
+	{
+		return end;
+	}
+
+	bool finished() const
+	{
+		return cursor >= end;
+	}
+
+private:
+	std::vector<Tween> children;
+	std::vector<int> offsets;
+	// Ticks each child has been stepped by.
+	std::vector<double> local;
+	// Children sorted by offset; order[next] is the first one not started.
+	std::vector<int> order;
+	std::size_t next = 0;
+	std::vector<int> running;
+	double cursor = 0;
+	int end = 0;
+
+	void start(int i)
+	{
+		const double s = cursor - offsets[i] - local[i];
+		children[i].step(s);
+		local[i] += s;
+		if (!children[i].finished())
+			running.push_back(i);
+	}
+
+	void seek(double c)
+	{
+		cursor = c;
+		running.clear();
+		next = 0;
+		for (std::size_t k = 0; k < order.size(); ++k)
+		{
+			const int i = order[k];
+			if (offsets[i] > cursor)
+			{
+				children[i].step(-local[i]);
+				local[i] = 0;
+				continue;
+			}
+
+			next = k + 1;
+			const double s = cursor - offsets[i] - local[i];
+			children[i].step(s);
+			local[i] += s;
+			if (!children[i].finished())
+				running.push_back(i);
+		}
+	}
+};
+
+typedef basic_microtween_timeline<> microtween_timeline;
@@ -0,0 +1,245 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timing wheel holding at most one pending event per id, keyed
+// on absolute time. Level 0 has a slot per tick for the next 256 ticks; each
+// level above covers 256 times the span of the one below and hands its slots
+// down as time reaches them. Events further out than the top level reaches
+// wait in its last slot and are placed again when it is handed down.
+//
+// schedule() and cancel() are O(1). advance() costs the events due plus one
+// hand-down per 256 ticks, skipping ahead when the lower levels are empty.
+class microtween_wheel
+{
+public:
+	microtween_wheel()
+	{
+		clear();
+	}
+
+	// Schedules id at time, replacing its pending event if it has one. Times
+	// not after the current time fire on the next advance().
+	void schedule(int id, std::int64_t time)
+	{
+		if (id >= static_cast<int>(where.size()))
+		{
+			next.resize(id + 1, -1);
+			prev.resize(id + 1, -1);
+			where.resize(id + 1, -1);
+			times.resize(id + 1, 0);
+		}
+		else if (where[id] >= 0)
+		{
+			unlink(id);
+		}
+		times[id] = time;
+		insert(id);
+	}
+
+	void cancel(int id)
+	{
+		if (id < static_cast<int>(where.size()) && where[id] >= 0)
+			unlink(id);
+	}
+
+	bool scheduled(int id) const
+	{
+		return id < static_cast<int>(where.size()) && where[id] >= 0;
+	}
+
+	// Number of pending events.
+	std::size_t size() const
+	{
+		return count;
+	}
+
+	void clear()
+	{
+		next.clear();
+		prev.clear();
+		where.clear();
+		times.clear();
+		overdue.clear();
+		for (int i = 0; i < slot_count; ++i)
+			head[i] = tail[i] = -1;
+		for (int i = 0; i < levels; ++i)
+			counts[i] = 0;
+		count = 0;
+		current = 0;
+	}
+
+	// Moves the wheel to time now and calls f(id) for every event due by then,
+	// in time order. f may schedule and cancel freely; events it schedules at
+	// or before now wait for the next call. The wheel never moves back, so an
+	// earlier now only delivers events that are overdue.
+	template <class F>
+	void advance(std::int64_t now, F&& f)
+	{
+		if (head[late] >= 0)
+		{
+			// Overdue events were listed as they were scheduled; ties keep
+			// that order.
+			overdue.clear();
+			for (int i = head[late]; i >= 0; i = next[i])
+				overdue.push_back(i);
+			std::stable_sort(overdue.begin(), overdue.end(), [this](int a, int b) { return times[a] < times[b]; });
+			for (int i : overdue)
+			{
+				unlink(i);
+				link(i, firing);
+			}
+			fire(firing, f);
+		}
+
+		while (current < now)
+		{
+			if (counts[0] == 0)
+			{
+				int k = 1;
+				while (k < levels && counts[k] == 0)
+					++k;
+				if (k == levels)
+				{
+					current = now;
+					break;
+				}
+
+				// Nothing can happen before the next hand-down from level k.
+				const std::int64_t to = (current | (span(k) - 1)) + 1;
+				if (to > now)
+				{
+					current = now;
+					break;
+				}
+				current = to;
+			}
+			else
+			{
+				++current;
+			}
+
+			if ((current & mask) == 0)
+				cascade();
+			fire(static_cast<int>(current & mask), f);
+		}
+	}
+
+private:
+	static const int bits = 8;
+	static const int slots = 1 << bits;
+	static const int mask = slots - 1;
+	static const int levels = 4;
+	// Wheel slots, then the list of overdue events and the list being fired.
+	static const int late = levels * slots;
+	static const int firing = late + 1;
+	static const int slot_count = firing + 1;
+
+	// Per id: neighbours in its slot's list, the slot (-1 if not scheduled)
+	// and the time it is due.
+	std::vector<int> next;
+	std::vector<int> prev;
+	std::vector<int> where;
+	std::vector<std::int64_t> times;
+	// Scratch list for sorting overdue events.
+	std::vector<int> overdue;
+
+	int head[slot_count];
+	int tail[slot_count];
+	std::size_t counts[levels];
+	std::size_t count;
+	std::int64_t current;
+
+	static std::int64_t span(int level)
+	{
+		return std::int64_t(1) << (bits * level);
+	}
+
+	void insert(int id)
+	{
+		const std::int64_t d = times[id] - current;
+		if (d <= 0)
+		{
+			link(id, late);
+			return;
+		}
+
+		int k = 0;
+		while (k + 1 < levels && d >= span(k + 1))
+			++k;
+		const std::int64_t t = d < span(levels) ? times[id] : current + span(levels) - 1;
+		link(id, k * slots + static_cast<int>((t >> (bits * k)) & mask));
+	}
+
+	void link(int id, int s)
+	{
+		if (s < late)
+			++counts[s / slots];
+		next[id] = -1;
+		prev[id] = tail[s];
+		if (tail[s] >= 0)
+			next[tail[s]] = id;
+		else
+			head[s] = id;
+		tail[s] = id;
+		where[id] = s;
+		++count;
+	}
+
+	void unlink(int id)
+	{
+		const int s = where[id];
+		if (prev[id] >= 0)
+			next[prev[id]] = next[id];
+		else
+			head[s] = next[id];
+		if (next[id] >= 0)
+			prev[next[id]] = prev[id];
+		else
+			tail[s] = prev[id];
+
+		if (s < late)
+			--counts[s / slots];
+		--count;
+		where[id] = -1;
+	}
+
+	// Hands the slots of the levels above down as their turn comes. Level k's
+	// slot comes up whenever level k - 1 wraps around.
+	void cascade()
+	{
+		for (int k = 1; k < levels; ++k)
+		{
+			const int index = static_cast<int>((current >> (bits * k)) & mask);
+			const int s = k * slots + index;
+			int i = head[s];
+			head[s] = tail[s] = -1;
+			while (i >= 0)
+			{
+				const int n = next[i];
+				--counts[k];
+				--count;
+				// Events due right now go to the level 0 slot fired next.
+				if (times[i] == current)
+					link(i, static_cast<int>(current & mask));
+				else
+					insert(i);
+				i = n;
+			}
+			if (index != 0)
+				break;
+		}
+	}
+
+	template <class F>
+	void fire(int s, F& f)
+	{
+		while (head[s] >= 0)
+		{
+			const int id = head[s];
+			unlink(id);
+			f(id);
+		}
+	}
+};
@@ -0,0 +1,163 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of threads running the chunks of a job, with work stealing. Each
+// thread starts with a contiguous share of chunk indices, takes chunks from
+// the front of its own share and, once that is empty, steals from the back of
+// the others'. The thread calling run() works as well, so threads == 1 runs
+// everything inline.
+class microtween_workers
+{
+public:
+	explicit microtween_workers(unsigned threads = std::thread::hardware_concurrency()) :
+		count(threads ? threads : 1), slots(new slot[threads ? threads : 1])
+	{
+		for (unsigned i = 1; i < count; ++i)
+			threads_.emplace_back([this, i] { work(i); });
+	}
+
+	microtween_workers(const microtween_workers&) = delete;
+	microtween_workers& operator=(const microtween_workers&) = delete;
+
+	~microtween_workers()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		start.notify_all();
+		for (auto& i : threads_)
+			i.join();
+	}
+
+	unsigned size() const
+	{
+		return count;
+	}
+
+	// Calls f(i) once for every i in [0, chunks) and returns when all calls
+	// are done. Calls run concurrently and in no particular order.
+	template <class F>
+	void run(int chunks, F&& f)
+	{
+		if (chunks <= 0)
+			return;
+
+		typedef typename std::remove_reference<F>::type fn;
+		job = [](void* context, int i) { (*static_cast<fn*>(context))(i); };
+		context = const_cast<void*>(static_cast<const void*>(&f));
+
+		for (unsigned i = 0; i < count; ++i)
+		{
+			const std::uint64_t begin = static_cast<std::uint64_t>(chunks) * i / count;
+			const std::uint64_t end = static_cast<std::uint64_t>(chunks) * (i + 1) / count;
+			slots[i].range.store(begin | end << 32, std::memory_order_relaxed);
+		}
+
+		busy.store(count - 1, std::memory_order_relaxed);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			++generation;
+		}
+		start.notify_all();
+
+		drain(0);
+
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [this] { return busy.load() == 0; });
+	}
+
+private:
+	// Remaining chunks [begin, end) of one thread, packed as begin | end << 32
+	// so the owner and thieves race on a single word. Padded to a cache line.
+	struct slot
+	{
+		std::atomic<std::uint64_t> range{ 0 };
+		char padding[64 - sizeof(std::atomic<std::uint64_t>)];
+	};
+
+	unsigned count;
+	std::unique_ptr<slot[]> slots;
+	std::vector<std::thread> threads_;
+
+	void (*job)(void*, int) = nullptr;
+	void* context = nullptr;
+
+	std::mutex mutex;
+	std::condition_variable start;
+	std::condition_variable done;
+	std::atomic<unsigned> busy{ 0 };
+	unsigned long generation = 0;
+	bool stop = false;
+
+	void work(unsigned self)
+	{
+		unsigned long seen = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				start.wait(lock, [&] { return stop || generation != seen; });
+				if (stop)
+					return;
+				seen = generation;
+			}
+
+			drain(self);
+
+			if (busy.fetch_sub(1) == 1)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				done.notify_one();
+			}
+		}
+	}
+
+	void drain(unsigned self)
+	{
+		int i;
+		while (take(slots[self].range, false, i))
+			job(context, i);
+
+		for (bool found = true; found;)
+		{
+			found = false;
+			for (unsigned k = 1; k < count; ++k)
+			{
+				std::atomic<std::uint64_t>& victim = slots[(self + k) % count].range;
+				while (take(victim, true, i))
+				{
+					found = true;
+					job(context, i);
+				}
+			}
+		}
+	}
+
+	// Takes one chunk from the front (owner) or the back (thief) of range.
+	static bool take(std::atomic<std::uint64_t>& range, bool back, int& i)
+	{
+		std::uint64_t r = range.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			const std::uint64_t begin = r & 0xffffffff;
+			const std::uint64_t end = r >> 32;
+			if (begin >= end)
+				return false;
+
+			const std::uint64_t next = back ? begin | (end - 1) << 32 : (begin + 1) | end << 32;
+			if (range.compare_exchange_weak(r, next, std::memory_order_acq_rel, std::memory_order_relaxed))
+			{
+				i = static_cast<int>(back ? end - 1 : begin);
+				return true;
+			}
+		}
+	}
+};
@@ -0,0 +1,29 @@
+#include "../catch.hpp"
+#include "../microtween.h"
+#include "../microtween_arena.h"
+
+TEST_CASE("tweens allocate every container from an arena")
+{
+	typedef basic_microtween<float, microtween_arena_allocator<float>> arena_tween;
+
+	microtween_arena arena;
+	const microtween_arena_allocator<float> alloc(arena);
+	const microtween_bezier curve(.25f, .1f, .25f, 1);
+	microtween_spline keys;
+	keys.key(0, 10).key(4, 20).key(8, 0);
+
+	int fired = 0;
+	arena_tween a(alloc);
+	a.reset(0).to(10, 5, microtween::easing::cubic_in).to(20, 5, curve).call([&] { ++fired; }).to(keys);
+	microtween b;
+	b.reset(0).to(10, 5, microtween::easing::cubic_in).to(20, 5, curve).to(keys);
+
+	REQUIRE(a.duration() == b.duration());
+	for (int c = 0; c <= a.duration(); ++c)
+		CHECK(a.get(c) == b.get(c));
+
+	arena_tween copy = a;
+	copy.step(12);
+	CHECK(fired == 1);
+	CHECK(copy.get() == b.get(12));
+}
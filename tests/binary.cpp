@@ -0,0 +1,42 @@
+#include "../catch.hpp"
+#include "../microtween_binary.h"
+#include <cstring>
+#include <vector>
+
+TEST_CASE("binary sequences play like the tweens written")
+{
+	microtween t;
+	t.reset(2).to(10, 30, microtween::easing::cubic_in).to(-4, 0).to(6, 25, microtween::easing::back_in_out);
+	microtween_binary_writer writer;
+	writer.add(t);
+	const std::vector<std::uint32_t> data = writer.data();
+
+	microtween_binary library;
+	REQUIRE(library.open(data.data(), data.size() * 4));
+	const microtween_binary::sequence s = library[0];
+	microtween copy = s.tween();
+	for (int c = 0; c <= 60; ++c)
+	{
+		CHECK(s.get(c) == t.get(c));
+		CHECK(copy.get(c) == t.get(c));
+	}
+}
+
+TEST_CASE("binary libraries with unknown easing ids are rejected")
+{
+	microtween t;
+	t.reset(0).to(1, 10).to(2, 10, microtween::easing::back_in_out);
+	microtween_binary_writer writer;
+	writer.add(t);
+	std::vector<std::uint32_t> data = writer.data();
+
+	// Second easing id of the only record, after the header, the directory,
+	// the from value, the count, two ends and two end times.
+	std::uint8_t* easings = reinterpret_cast<std::uint8_t*>(&data[microtween_format::header_words + 1 + 2 + 4]);
+	CHECK(easings[1] == static_cast<std::uint8_t>(microtween::easing::back_in_out));
+	easings[1] = 200;
+
+	microtween_binary library;
+	CHECK(!library.open(data.data(), data.size() * 4));
+	CHECK(library.size() == 0);
+}
@@ -0,0 +1,29 @@
+#include "../catch.hpp"
+#include "../microtween_pool.h"
+#include <functional>
+
+TEST_CASE("empty callbacks are skipped")
+{
+	microtween m;
+	m.reset(0).to(1, 2).call(microtween::cb_t()).to(2, 2).call(std::function<void()>());
+	m.step(5);
+	CHECK(m.get() == 2);
+
+	void (*none)() = nullptr;
+	CHECK(!microtween::cb_t(none));
+	CHECK(!microtween::cb_t(std::function<void()>()));
+
+	microtween_pool pool;
+	const int id = pool.add(microtween().reset(0).to(1, 2).call(std::function<void()>()));
+	pool.step_all(3);
+	CHECK(pool.finished(id));
+}
+
+TEST_CASE("an empty callback removes the segment's callback")
+{
+	int calls = 0;
+	microtween m;
+	m.reset(0).to(1, 2).call([&] { ++calls; }).call(microtween::cb_t()).to(2, 2).call([&] { ++calls; });
+	m.step(5);
+	CHECK(calls == 1);
+}
@@ -0,0 +1,102 @@
+#include "../catch.hpp"
+#include "../microtween_loader.h"
+#include <cstring>
+#include <string>
+
+namespace
+{
+	bool load(microtween_loader& loader, const char* text)
+	{
+		return loader.load(text, std::strlen(text));
+	}
+}
+
+TEST_CASE("loader builds one tween per line")
+{
+	microtween_pool pool;
+	microtween_loader loader(pool);
+	REQUIRE(load(loader, "from 10; to 30 20 cubic_in; wait 5   # comment; to 99 1\r\n\nto -2.5e1 10\n"));
+	REQUIRE(loader.tweens().size() == 2);
+	const int a = loader.tweens()[0];
+	const int b = loader.tweens()[1];
+
+	microtween t;
+	t.reset(10).to(30, 20, microtween::easing::cubic_in).wait(5);
+	microtween u;
+	u.reset(0).to(-25, 10);
+	for (int c = 0; c < 30; ++c)
+	{
+		CHECK(pool.get(a) == Approx(t.get(c)));
+		CHECK(pool.get(b) == Approx(u.get(c)));
+		pool.step_all(1);
+	}
+	CHECK(pool.finished(a));
+	CHECK(pool.finished(b));
+}
+
+TEST_CASE("loader accepts text split anywhere")
+{
+	const std::string text = "from 1.5; to 300 300 quadratic_out # to 5 5\nwait 10; to 2 4 back_in_out\n";
+	for (std::size_t k = 1; k <= text.size(); ++k)
+	{
+		microtween_pool whole_pool;
+		microtween_loader whole(whole_pool);
+		REQUIRE(whole.load(text.data(), text.size()));
+
+		microtween_pool split_pool;
+		microtween_loader split(split_pool);
+		for (std::size_t i = 0; i < text.size(); i += k)
+			split.feed(text.data() + i, std::min(k, text.size() - i));
+		REQUIRE(split.finish());
+		REQUIRE(split.tweens() == whole.tweens());
+
+		for (int c = 0; c < 320; c += 7)
+		{
+			for (int id : whole.tweens())
+				CHECK(split_pool.get(id) == whole_pool.get(id));
+			whole_pool.step_all(7);
+			split_pool.step_all(7);
+		}
+	}
+}
+
+TEST_CASE("loader reports the first line with an error")
+{
+	const char* const bad[] = {
+		"to 1 2; from 3",
+		"to 1 2.5",
+		"to 1 -2",
+		"to 1e999 5",
+		"to 1e39 5",
+		"from 5e-999e; to 1 1",
+		"to 1 2 bouncy",
+		"wait",
+		"to 1",
+		"jump 3",
+		"to 1 2 linear 4",
+		"to 123456789012345678901234567890123 1"
+	};
+	for (const char* line : bad)
+	{
+		microtween_pool pool;
+		microtween_loader loader(pool);
+		const std::string text = std::string("to 1 1\r\n# fine\n\n") + line + "\nto 2 2\nwait\n";
+		CHECK(!loader.load(text.data(), text.size()));
+		CHECK(loader.error() == 4);
+	}
+
+	microtween_pool pool;
+	microtween_loader loader(pool);
+	CHECK(load(loader, "to 0e999 1; wait 0"));
+	CHECK(loader.error() == 0);
+}
+
+TEST_CASE("loader keeps the statements before an error")
+{
+	microtween_pool pool;
+	microtween_loader loader(pool);
+	CHECK(!load(loader, "from 2; to 8 4; to 1 x; to 9 9\n"));
+	REQUIRE(loader.tweens().size() == 1);
+	pool.step_all(100);
+	CHECK(pool.get(loader.tweens()[0]) == 8);
+}
@@ -0,0 +1,47 @@
+#include "../catch.hpp"
+#include "../microtween.h"
+#include <cmath>
+
+namespace
+{
+	// Largest difference between l and the exact easing over a sweep of [0, 1].
+	float sweep(const microtween_lut& l, microtween::easing e)
+	{
+		const int n = 1 << 20;
+		float error = 0;
+		for (int i = 0; i <= n; ++i)
+		{
+			const float t = static_cast<float>(i) / n;
+			error = std::max(error, std::fabs(l(t, e) - microtween::interpolate(t, e)));
+		}
+		return error;
+	}
+}
+
+TEST_CASE("lut errors bound the easings it serves")
+{
+	for (int resolution : { 256, 1024 })
+	{
+		const microtween_lut l(resolution, 1.f);
+		for (int k = 0; k <= static_cast<int>(microtween::easing::back_in_out); ++k)
+		{
+			const microtween::easing e = static_cast<microtween::easing>(k);
+			CHECK(sweep(l, e) <= l.error(e));
+		}
+	}
+}
+
+TEST_CASE("lut evaluates easings above max_error exactly")
+{
+	const microtween_lut l(1024, 8e-5f);
+	CHECK(l.error(microtween::easing::elastic_in_out) < 0);
+	CHECK(l.error(microtween::easing::cubic_in) >= 0);
+	CHECK(l(0.9985f, microtween::easing::elastic_in_out) == microtween::interpolate(0.9985f, microtween::easing::elastic_in_out));
+}
+
+TEST_CASE("lut resolution is at least 2")
+{
+	const microtween_lut l(1);
+	CHECK(l(0.5f, microtween::easing::linear) == 0.5f);
+	CHECK(l(1.f, microtween::easing::cubic_in) == 1.f);
+}
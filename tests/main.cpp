@@ -0,0 +1,6 @@
+// Unit tests, built from this directory with
+//   g++ -std=c++14 -fpermissive -pthread -I.. *.cpp
+// Catch's POSIX signal handler doesn't compile against current glibc.
+#define CATCH_CONFIG_NO_POSIX_SIGNALS
+#define CATCH_CONFIG_MAIN
+#include "../catch.hpp"
@@ -0,0 +1,53 @@
+#include "../catch.hpp"
+#include "../microtween_packed.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+TEST_CASE("packed sequences play like the tweens they hold")
+{
+	std::mt19937 rng(17);
+	microtween_packed bank(-100, 100);
+	std::vector<microtween> originals;
+	for (int i = 0; i < 300; ++i)
+	{
+		microtween t;
+		t.reset(static_cast<float>(rng() % 2001) / 10 - 100);
+		const int n = rng() % 6;
+		for (int k = 0; k < n; ++k)
+			t.to(static_cast<float>(rng() % 2001) / 10 - 100, rng() % 4 ? rng() % 50 : 0, static_cast<microtween::easing>(rng() % 28));
+		originals.push_back(t);
+		REQUIRE(bank.add(t) == i);
+	}
+
+	std::vector<float> range(100);
+	for (std::size_t i = 0; i < bank.size(); ++i)
+	{
+		const microtween t = bank.tween(i);
+		CHECK(bank.duration(i) == originals[i].duration());
+		for (int c = 0; c < 260; ++c)
+		{
+			CHECK(bank.get(i, c) == t.get(c));
+			CHECK(std::fabs(bank.get(i, c) - originals[i].get(c)) <= 4 * bank.error());
+		}
+
+		const int c0 = rng() % 20;
+		const int stride = 1 + rng() % 3;
+		bank.get_range(i, c0, 100, stride, range.data());
+		for (int k = 0; k < 100; ++k)
+			CHECK(range[k] == Approx(t.get(c0 + k * stride)).margin(1e-3));
+	}
+}
+
+TEST_CASE("packed bank refuses tweens it can't hold")
+{
+	microtween_packed bank(0, 10);
+	const microtween_bezier curve(.25f, .1f, .25f, 1);
+	CHECK(bank.add(microtween().reset(0).to(11, 5)) == -1);
+	CHECK(bank.add(microtween().reset(-1).to(1, 5)) == -1);
+	CHECK(bank.add(microtween().reset(0).to(1, 70000)) == -1);
+	CHECK(bank.add(microtween().reset(0).to(1, 5, curve)) == -1);
+	CHECK(bank.size() == 0);
+	CHECK(bank.add(microtween().reset(0).to(10, 5)) == 0);
+	CHECK(bank.get(0, 5) == 10);
+}
@@ -0,0 +1,167 @@
+#include "../catch.hpp"
+#include "../microtween_pool.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+TEST_CASE("pool callbacks may append while compaction is due")
+{
+	microtween_pool pool;
+	int calls = 0;
+	int later = 0;
+
+	microtween first;
+	first.reset(0).to(1, 1).call([&]
+	{
+		++calls;
+		for (int k = 0; k < 3000; ++k)
+			pool.append(1 + k % 600, static_cast<float>(k), 1);
+	});
+	pool.add(first);
+	for (int i = 0; i < 600; ++i)
+		pool.create(0);
+
+	// Ends on the same tick, so its callback id is queued before the first
+	// callback grows the segment array past the compaction threshold.
+	microtween second;
+	second.reset(0).to(1, 1).call([&] { ++later; });
+	const int id = pool.add(second);
+
+	pool.step_all(1);
+	CHECK(calls == 1);
+	CHECK(later == 1);
+	CHECK(pool.finished(id));
+	CHECK(!pool.finished(1));
+
+	for (int i = 0; i < 5; ++i)
+		pool.step_all(1);
+	CHECK(calls == 1);
+	CHECK(later == 1);
+	CHECK(pool.get(1) == 2400);
+}
+
+namespace
+{
+	// Random sequence with zero-length segments, curves and callbacks counting
+	// into fired.
+	microtween random_tween(std::mt19937& rng, const microtween_bezier& curve, int& fired)
+	{
+		microtween t;
+		t.reset(static_cast<float>(rng() % 100));
+		const int n = rng() % 6;
+		for (int i = 0; i < n; ++i)
+		{
+			const float end = static_cast<float>(rng() % 1000) - 500;
+			const int d = rng() % 4 ? rng() % 40 : 0;
+			if (rng() % 8 == 0)
+				t.to(end, d, curve);
+			else
+				t.to(end, d, static_cast<microtween::easing>(rng() % 28));
+			if (rng() % 3 == 0)
+				t.call([&fired] { ++fired; });
+		}
+		return t;
+	}
+
+	bool close(float a, float b)
+	{
+		return std::fabs(a - b) <= 1e-3f * (1 + std::fabs(a)) || (a != a && b != b);
+	}
+}
+
+TEST_CASE("pool plays tweens like microtween")
+{
+	const int n = 2000;
+	std::mt19937 rng(7);
+	const microtween_bezier curve(.25f, .1f, .25f, 1);
+	std::vector<int> fired_tweens(n);
+	std::vector<int> fired_pool(n);
+
+	std::vector<microtween> tweens;
+	microtween_pool pool;
+	for (int i = 0; i < n; ++i)
+	{
+		std::mt19937 same = rng;
+		tweens.push_back(random_tween(same, curve, fired_tweens[i]));
+		pool.add(random_tween(rng, curve, fired_pool[i]));
+	}
+
+	int wrong = 0;
+	for (int step = 0; step < 60; ++step)
+	{
+		const int s = rng() % 5;
+		pool.step_all(s);
+		for (int i = 0; i < n; ++i)
+		{
+			tweens[i].step(s);
+			wrong += !close(tweens[i].get(), pool.get(i));
+			wrong += tweens[i].finished() != pool.finished(i);
+			wrong += fired_tweens[i] != fired_pool[i];
+		}
+	}
+	CHECK(wrong == 0);
+}
+
+TEST_CASE("parallel step matches serial step")
+{
+	const int n = 30000;
+	std::mt19937 rng(11);
+	const microtween_bezier curve(.42f, 0, .58f, 1);
+	int fired_serial = 0;
+	int fired_parallel = 0;
+
+	microtween_pool serial;
+	microtween_pool parallel;
+	for (int i = 0; i < n; ++i)
+	{
+		std::mt19937 same = rng;
+		serial.add(random_tween(same, curve, fired_serial));
+		parallel.add(random_tween(rng, curve, fired_parallel));
+	}
+
+	microtween_workers workers(8);
+	int wrong = 0;
+	for (int step = 0; step < 120; ++step)
+	{
+		serial.step_all(1);
+		parallel.step_all(1, workers);
+		for (int i = 0; i < n; ++i)
+			wrong += serial.get(i) != parallel.get(i) && !(serial.get(i) != serial.get(i) && parallel.get(i) != parallel.get(i));
+		wrong += serial.completed() != parallel.completed();
+	}
+	CHECK(wrong == 0);
+	CHECK(fired_serial == fired_parallel);
+}
+
+TEST_CASE("pool samples splines like microtween")
+{
+	microtween_spline track;
+	for (int k = 0; k <= 40; ++k)
+		track.key(k * 7.5f, static_cast<float>(k % 5) * 20 - (k % 3) * 15);
+	microtween_spline flat;
+	flat.key(0, 3).key(10, 3);
+
+	std::mt19937 rng(3);
+	std::vector<microtween> tweens;
+	microtween_pool pool;
+	for (int i = 0; i < 200; ++i)
+	{
+		microtween t;
+		t.reset(0).to(5, rng() % 20).to(i % 2 ? track : flat).to(track).to(1, 10);
+		tweens.push_back(t);
+		pool.add(t);
+	}
+
+	int wrong = 0;
+	for (int step = 0; step < 400; ++step)
+	{
+		const int s = rng() % 4;
+		pool.step_all(s);
+		for (int i = 0; i < 200; ++i)
+		{
+			tweens[i].step(s);
+			wrong += !close(tweens[i].get(), pool.get(i));
+		}
+	}
+	CHECK(wrong == 0);
+}
@@ -0,0 +1,60 @@
+#include "../catch.hpp"
+#include "../microtween_queue.h"
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST_CASE("queue feeds a pool stepped on another thread")
+{
+	const int producers = 4;
+	const int count = 20000;
+
+	microtween_command_queue queue(1 << 12);
+	microtween_pool pool;
+	std::atomic<int> running{ producers };
+	std::vector<std::vector<std::pair<int, float>>> kept(producers);
+
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; ++p)
+	{
+		threads.emplace_back([&, p]
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				int id;
+				while ((id = queue.create(0)) < 0)
+					std::this_thread::yield();
+				const float end = static_cast<float>(p * count + i);
+				while (!queue.append(id, end, 1 + i % 7))
+					std::this_thread::yield();
+				if (i % 3 == 0)
+				{
+					while (!queue.kill(id))
+						std::this_thread::yield();
+				}
+				else
+				{
+					kept[p].push_back({ id, end });
+				}
+			}
+			--running;
+		});
+	}
+
+	while (running > 0)
+	{
+		queue.drain(pool);
+		pool.step_all(1);
+	}
+	for (auto& i : threads)
+		i.join();
+	queue.drain(pool);
+	for (int i = 0; i < 8; ++i)
+		pool.step_all(1);
+
+	int wrong = 0;
+	for (const auto& k : kept)
+		for (const auto& i : k)
+			wrong += !pool.finished(i.first) || pool.get(i.first) != i.second;
+	CHECK(wrong == 0);
+}
@@ -0,0 +1,23 @@
+#include "../catch.hpp"
+#include "../microtween.h"
+#include <algorithm>
+#include <cmath>
+
+TEST_CASE("springs end on their end value")
+{
+	const float cases[][3] = {
+		{ 170, 0, 0 }, { 170, 0, 5 }, { 100, 0.001f, 0 }, { 100, 2, 0 },
+		{ 170, 26, 0 }, { 300, 10, 10 }, { 100, 20, 0 }, { 100, 50, 0 }
+	};
+	for (const auto& c : cases)
+	{
+		const microtween_spring s(c[0], c[1], c[2]);
+		// Samples 1e-4 apart may differ by the speed of the motion, but there
+		// is no jump to the end at t = 1.
+		float worst = 0;
+		for (int i = 0; i < 10000; ++i)
+			worst = std::max(worst, std::fabs(s(i / 10000.f) - s((i + 1) / 10000.f)));
+		CHECK(worst < 0.01f);
+		CHECK(s(1.f) == 1.f);
+	}
+}
@@ -0,0 +1,52 @@
+#include "../catch.hpp"
+#include "../microtween_timeline.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+	microtween random_child(std::mt19937& rng)
+	{
+		microtween t;
+		t.reset(static_cast<float>(rng() % 100));
+		const int n = 1 + rng() % 4;
+		for (int k = 0; k < n; ++k)
+			t.to(static_cast<float>(rng() % 100), rng() % 30, static_cast<microtween::easing>(rng() % 28));
+		return t;
+	}
+}
+
+TEST_CASE("timeline plays children like tweens stepped on their own")
+{
+	std::mt19937 rng(21);
+	microtween_timeline timeline;
+	std::vector<microtween> children;
+	std::vector<int> offsets;
+	double cursor = 0;
+	int wrong = 0;
+
+	for (int round = 0; round < 400; ++round)
+	{
+		// Children are added along the way, some with offsets already passed.
+		if (round % 4 == 0)
+		{
+			children.push_back(random_child(rng));
+			offsets.push_back(static_cast<int>(cursor) - 20 + static_cast<int>(rng() % 60));
+			timeline.add(children.back(), offsets.back());
+		}
+
+		const double s = rng() % 10 ? (rng() % 16) / 4. : -std::min(cursor, (rng() % 80) / 2.);
+		timeline.step(s);
+		cursor += s;
+
+		std::size_t playing = 0;
+		for (std::size_t i = 0; i < children.size(); ++i)
+		{
+			const double local = std::max(0., cursor - offsets[i]);
+			wrong += !(timeline.get(static_cast<int>(i)) == Approx(children[i].get(local)).margin(1e-3));
+			playing += cursor >= offsets[i] && local < children[i].duration();
+		}
+		wrong += timeline.playing() != playing;
+	}
+	CHECK(wrong == 0);
+}
@@ -0,0 +1,167 @@
+#include "../catch.hpp"
+#include "../microtween.h"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// Callbacks append their name and the tween's value when called.
+	struct recorder
+	{
+		std::string names;
+		std::vector<float> values;
+	};
+
+	void build(microtween& m, recorder& r, int repeats, bool yoyo)
+	{
+		m.reset(0)
+			.to(10, 10).call([&m, &r] { r.names += 'A'; r.values.push_back(m.get()); })
+			.to(20, 10).call([&m, &r] { r.names += 'B'; r.values.push_back(m.get()); })
+			.repeat(repeats, yoyo);
+	}
+
+	// Plays the tween of build() to end in steps of s and returns the names.
+	std::string play(int repeats, bool yoyo, double s, float* last, double end = 75)
+	{
+		recorder r;
+		microtween m;
+		build(m, r, repeats, yoyo);
+		for (double c = 0; c < end; c += s)
+			m.step(std::min(s, end - c));
+		for (std::size_t k = 0; k < r.names.size(); ++k)
+			CHECK(r.values[k] == (r.names[k] == 'A' ? 10 : 20));
+		if (last)
+			*last = m.get();
+		return r.names;
+	}
+}
+
+TEST_CASE("repeating tweens call back on every pass")
+{
+	for (double s : { 1., 7., 75. })
+	{
+		float last;
+		CHECK(play(2, false, s, &last) == "ABABAB");
+		CHECK(last == 20);
+		CHECK(play(-1, false, s, &last) == "ABABABA");
+		CHECK(last == 15);
+	}
+}
+
+TEST_CASE("yoyo passes cross the segment ends backwards")
+{
+	// A backward pass calls A on its way down but not B at the turn, which
+	// the forward pass before it already called.
+	for (double s : { 1., 7., 75. })
+	{
+		float last;
+		CHECK(play(2, true, s, &last) == "ABAAB");
+		CHECK(last == 20);
+		CHECK(play(3, true, s, &last) == "ABAABA");
+		CHECK(last == 5);
+		CHECK(play(1, true, s, &last, 45) == "ABA");
+		CHECK(last == 0);
+		CHECK(play(-1, true, s, &last) == "ABAABA");
+		CHECK(last == 5);
+	}
+}
+
+TEST_CASE("repeating tweens map times at pass boundaries")
+{
+	recorder r;
+	microtween forward;
+	build(forward, r, 2, false);
+	CHECK(forward.get(0) == 0);
+	CHECK(forward.get(19.5) == 19.5f);
+	CHECK(forward.get(20) == 0);
+	CHECK(forward.get(40) == 0);
+	CHECK(forward.get(60) == 20);
+	CHECK(forward.get(1000) == 20);
+
+	microtween yoyo;
+	build(yoyo, r, 2, true);
+	CHECK(yoyo.get(20) == 20);
+	CHECK(yoyo.get(30) == 10);
+	CHECK(yoyo.get(40) == 0);
+	CHECK(yoyo.get(60) == 20);
+	CHECK(yoyo.get(1000) == 20);
+
+	// An odd number of repeats ends backwards, on the from value.
+	microtween odd;
+	build(odd, r, 1, true);
+	CHECK(odd.get(39) == 1);
+	CHECK(odd.get(40) == 0);
+	CHECK(odd.get(1000) == 0);
+
+	microtween endless;
+	build(endless, r, -1, true);
+	CHECK(endless.get(200) == 0);
+	CHECK(endless.get(220) == 20);
+	CHECK(endless.get(225) == 15);
+	CHECK(r.names.empty());
+}
+
+TEST_CASE("stepping a repeating tween matches get at the cursor")
+{
+	std::mt19937 rng(9);
+	for (int repeats : { 0, 1, 2, 3, -1 })
+	{
+		for (bool yoyo : { false, true })
+		{
+			recorder r;
+			microtween m;
+			build(m, r, repeats, yoyo);
+			recorder q;
+			microtween reference;
+			build(reference, q, repeats, yoyo);
+
+			double c = 0;
+			for (int k = 0; k < 200; ++k)
+			{
+				const double s = (rng() % 80) / 8.;
+				m.step(s);
+				c += s;
+				CHECK(m.get() == Approx(reference.get(c)));
+			}
+		}
+	}
+}
+
+TEST_CASE("one large step calls back every segment crossed in order")
+{
+	recorder r;
+	microtween m;
+	m.reset(0);
+	for (int k = 0; k < 8; ++k)
+		m.to(static_cast<float>(k + 1), 3 + k % 3).call([&m, &r, k] { r.names += static_cast<char>('a' + k); r.values.push_back(m.get()); });
+
+	m.step(1000);
+	CHECK(r.names == "abcdefgh");
+	for (int k = 0; k < 8; ++k)
+		CHECK(r.values[k] == k + 1);
+	CHECK(m.get() == 8);
+	CHECK(m.finished());
+}
+
+TEST_CASE("zero-length segments call back within (cursor, cursor + s]")
+{
+	recorder r;
+	microtween m;
+	m.reset(0)
+		.to(3, 0).call([&m, &r] { r.names += 'Z'; r.values.push_back(m.get()); })
+		.to(5, 10).call([&m, &r] { r.names += 'A'; r.values.push_back(m.get()); })
+		.to(7, 0).call([&m, &r] { r.names += 'B'; r.values.push_back(m.get()); })
+		.to(9, 10).call([&m, &r] { r.names += 'C'; r.values.push_back(m.get()); });
+
+	// The segment ending at 0 is never crossed.
+	m.step(9.5);
+	CHECK(r.names.empty());
+	m.step(.5);
+	CHECK(r.names == "AB");
+	m.step(1);
+	CHECK(r.names == "AB");
+	m.step(50);
+	CHECK(r.names == "ABC");
+	CHECK(r.values == std::vector<float>({ 5, 7, 9 }));
+}
@@ -0,0 +1,64 @@
+#include "../catch.hpp"
+#include "../microtween_wheel.h"
+#include <map>
+#include <random>
+#include <vector>
+
+TEST_CASE("wheel delivers due events in time order")
+{
+	std::mt19937_64 rng(5);
+	microtween_wheel wheel;
+	// Reference: pending time of each id.
+	std::map<int, std::int64_t> pending;
+	std::int64_t now = 0;
+	int wrong = 0;
+
+	for (int round = 0; round < 20000; ++round)
+	{
+		const int ops = rng() % 8;
+		for (int k = 0; k < ops; ++k)
+		{
+			const int id = rng() % 500;
+			if (rng() % 5 == 0)
+			{
+				wheel.cancel(id);
+				pending.erase(id);
+				continue;
+			}
+
+			// Mostly near, sometimes overdue, sometimes beyond the top level.
+			std::int64_t t = now + static_cast<std::int64_t>(rng() % 600);
+			if (rng() % 6 == 0)
+				t = now - static_cast<std::int64_t>(rng() % 300);
+			else if (rng() % 50 == 0)
+				t = now + static_cast<std::int64_t>(rng() % (std::int64_t(1) << 36));
+			wheel.schedule(id, t);
+			pending[id] = t;
+		}
+
+		if (rng() % 100 == 0)
+			now += static_cast<std::int64_t>(rng() % (std::int64_t(1) << 34));
+		else
+			now += rng() % 300;
+
+		std::int64_t previous = INT64_MIN;
+		wheel.advance(now, [&](int id)
+		{
+			const auto it = pending.find(id);
+			if (it == pending.end() || it->second > now || it->second < previous)
+			{
+				++wrong;
+				return;
+			}
+			previous = it->second;
+			pending.erase(it);
+		});
+
+		for (const auto& i : pending)
+			wrong += i.second <= now;
+		wrong += wheel.size() != pending.size();
+		if (wrong)
+			break;
+	}
+	CHECK(wrong == 0);
+}